@@ -0,0 +1,217 @@
+/**
+ * @file attacks.cpp
+ * @brief Implementation file for the precomputed attack tables of the pieces
+ */
+
+#include "attacks.h"
+
+Magic rookMagics[64];
+Magic bishopMagics[64];
+bool usePext = false;
+
+Bitboard knightTable[64];
+Bitboard kingTable[64];
+Bitboard pawnTable[2][64];
+Bitboard betweenTable[64][64];
+
+// one entry per relevant occupancy of every square (2^12 max for a rook, 2^9 for a bishop)
+static Bitboard rookTable[0x19000];
+static Bitboard bishopTable[0x1480];
+
+static const int rookDirections[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+static const int bishopDirections[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+// multipliers found offline by a random search, so that no two occupancies
+// with different attacks share an index
+static const Bitboard rookMultipliers[64] = {
+    0x1080004008801020ULL, 0x0840092002C03000ULL, 0x1900200010400900ULL, 0x0880100008000480ULL,
+    0x4200100420080200ULL, 0x8100020100080400ULL, 0x0200040110886200ULL, 0x0200008040220411ULL,
+    0x0404800084400220ULL, 0x0000401000402000ULL, 0x0086001081220440ULL, 0x0408800800100280ULL,
+    0x000A001201040820ULL, 0x8848800200840080ULL, 0x4001000100040200ULL, 0x0442000102105084ULL,
+    0x9080010020804100ULL, 0x0040404000201009ULL, 0x0000808010002009ULL, 0x2200090021D00100ULL,
+    0x0008008008040080ULL, 0x0004004002010040ULL, 0x0011040008015042ULL, 0x00000A0001768104ULL,
+    0x0000800080204009ULL, 0x2010004140002001ULL, 0x9800200280100080ULL, 0x1000100080080080ULL,
+    0x0442000A00049020ULL, 0x2100040080020080ULL, 0x0800120400900148ULL, 0x0010040A00128541ULL,
+    0x2800804000800030ULL, 0x1010002000400041ULL, 0x4000200011004100ULL, 0x0610008410800800ULL,
+    0x0400802402800800ULL, 0xC100020080800400ULL, 0x0002000802000401ULL, 0x0182085882000401ULL,
+    0x0220204000808000ULL, 0x2860100040024022ULL, 0x0001002004110040ULL, 0x99101042000A0020ULL,
+    0x0004080004008080ULL, 0x0010040002008080ULL, 0x2012004881020004ULL, 0x8300842444820011ULL,
+    0x0088403882010200ULL, 0x0820400080210100ULL, 0x0110910040A00300ULL, 0x0801100280080480ULL,
+    0x0242009008200600ULL, 0x1002000489500200ULL, 0x0040800200010080ULL, 0x0091800041000080ULL,
+    0x0000209300488001ULL, 0x04C1002414824001ULL, 0x020020000B001041ULL, 0x7000100004200901ULL,
+    0x8002002004100802ULL, 0x30010002084C0007ULL, 0x0888221800813004ULL, 0x4000002840840112ULL
+};
+
+static const Bitboard bishopMultipliers[64] = {
+    0x10102002004A1420ULL, 0x8020040400584008ULL, 0x10510800811201C8ULL, 0x5204042080000088ULL,
+    0x2204106880000002ULL, 0x1401042004000000ULL, 0x0400880410042004ULL, 0x0028208200A02020ULL,
+    0x1500241990010E00ULL, 0x8001200182020A40ULL, 0x40004101030B0000ULL, 0x8002041042000100ULL,
+    0x4010011041020038ULL, 0x0000010421044000ULL, 0x1500210808020A00ULL, 0x8000088400880520ULL,
+    0x0405004010040100ULL, 0x1005823210040108ULL, 0x2708008102040011ULL, 0x4048200404009100ULL,
+    0x0018104101400024ULL, 0x0003000601190101ULL, 0x8004803108491000ULL, 0x8014241200820800ULL,
+    0x0006E080100C3040ULL, 0x0501044A11041800ULL, 0x9020300008004045ULL, 0x0894080000220040ULL,
+    0x1001010083104000ULL, 0x5004030040900080ULL, 0x000400422C012400ULL, 0x0002128698404812ULL,
+    0x1010108404900440ULL, 0x0928021182084100ULL, 0x2006080409020024ULL, 0x1010202020180080ULL,
+    0xA010008200202200ULL, 0x2098015100019004ULL, 0x0002041440810811ULL, 0x802A02020000B098ULL,
+    0x0009015090004060ULL, 0x4000821082081001ULL, 0x0100210040420800ULL, 0x0800004010488A00ULL,
+    0x2000081104004040ULL, 0x4C8E029015000082ULL, 0x0420340322224842ULL, 0x1298260043400210ULL,
+    0x0000822802400008ULL, 0x00008A0101600000ULL, 0x3040003412080021ULL, 0x3040290220884800ULL,
+    0x4A1500401041004AULL, 0x8010200282020781ULL, 0x0020203142209091ULL, 0x0070300600902110ULL,
+    0x0040808800B62048ULL, 0x0000810400C44420ULL, 0x00080400440C0441ULL, 0x8340080020840411ULL,
+    0x0000000104208200ULL, 0x0000800810D00080ULL, 0x0400530411080200ULL, 0x4040702400932244ULL
+};
+
+// ------------------------------------------------
+//               TABLE INDEXING
+// ------------------------------------------------
+
+/**
+ * @brief Check if the CPU running the program has the BMI2 instructions
+*/
+static bool cpuHasBmi2() {
+#if defined(__x86_64__)
+    return __builtin_cpu_supports("bmi2");
+#else
+    return false;
+#endif
+}
+
+// ------------------------------------------------
+//               TABLE GENERATION
+// ------------------------------------------------
+
+/**
+ * @brief Compute the attacks of a sliding piece by walking its rays until a blocker
+ * @param square The square of the piece
+ * @param occupancy The occupancy of the board
+ * @param directions The 4 (line, column) steps of the piece
+ * @return The attacked squares, including the blockers
+*/
+static Bitboard slidingAttacks(int square, Bitboard occupancy, const int directions[4][2]) {
+    Bitboard attacks = 0;
+
+    for (int d = 0; d < 4; d++) {
+        int line = squareLine(square) + directions[d][0];
+        int column = squareColumn(square) + directions[d][1];
+
+        while (line >= 0 && line < 8 && column >= 0 && column < 8) {
+            Bitboard bit = squareBit(squareIndex(line, column));
+            attacks |= bit;
+            if (occupancy & bit) {
+                break;
+            }
+
+            line += directions[d][0];
+            column += directions[d][1];
+        }
+    }
+
+    return attacks;
+}
+
+/**
+ * @brief Fill the magic entries and the attack table of a sliding piece
+ * @param magics The 64 magic entries to fill
+ * @param multipliers The 64 magic multipliers of the piece
+ * @param table The attack table shared by the 64 squares
+ * @param directions The 4 (line, column) steps of the piece
+*/
+static void initSlider(Magic magics[64], const Bitboard multipliers[64], Bitboard* table, const int directions[4][2]) {
+    Bitboard* next = table;
+
+    for (int square = 0; square < 64; square++) {
+        // the edges only matter if the piece stands on them
+        Bitboard edges =
+            ((0xFFULL | 0xFFULL << 56) & ~(0xFFULL << (8 * squareLine(square)))) |
+            ((0x0101010101010101ULL | 0x8080808080808080ULL) & ~(0x0101010101010101ULL << squareColumn(square)));
+
+        Magic & entry = magics[square];
+        entry.mask = slidingAttacks(square, 0, directions) & ~edges;
+        entry.shift = 64 - popCount(entry.mask);
+        entry.magic = multipliers[square];
+        entry.attacks = next;
+
+        // enumerate every subset of the mask (Carry-Rippler trick)
+        Bitboard subset = 0;
+        do {
+            entry.attacks[magicIndex(entry, subset)] = slidingAttacks(square, subset, directions);
+            subset = (subset - entry.mask) & entry.mask;
+        } while (subset);
+
+        next += Bitboard(1) << popCount(entry.mask);
+    }
+}
+
+/**
+ * @brief Compute the squares reached by single steps from a square
+ * @param square The start square
+ * @param steps The (line, column) steps
+ * @param count The number of steps
+ * @return The reached squares inside the board
+*/
+static Bitboard stepAttacks(int square, const int steps[][2], int count) {
+    Bitboard attacks = 0;
+
+    for (int s = 0; s < count; s++) {
+        int line = squareLine(square) + steps[s][0];
+        int column = squareColumn(square) + steps[s][1];
+        if (line >= 0 && line < 8 && column >= 0 && column < 8) {
+            attacks |= squareBit(squareIndex(line, column));
+        }
+    }
+
+    return attacks;
+}
+
+/**
+ * @brief Fill the attack tables of the knight, the king and the pawns
+*/
+static void initLeapers() {
+    static const int knightSteps[8][2] = {{2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2}};
+    static const int kingSteps[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    static const int whitePawnSteps[2][2] = {{1, -1}, {1, 1}};
+    static const int blackPawnSteps[2][2] = {{-1, -1}, {-1, 1}};
+
+    for (int square = 0; square < 64; square++) {
+        knightTable[square] = stepAttacks(square, knightSteps, 8);
+        kingTable[square] = stepAttacks(square, kingSteps, 8);
+        pawnTable[colorIndex(Color::WHITE)][square] = stepAttacks(square, whitePawnSteps, 2);
+        pawnTable[colorIndex(Color::BLACK)][square] = stepAttacks(square, blackPawnSteps, 2);
+    }
+}
+
+/**
+ * @brief Fill the table of the squares between two aligned squares, once the slider tables are built
+*/
+static void initBetween() {
+    for (int from = 0; from < 64; from++) {
+        for (int to = 0; to < 64; to++) {
+            Bitboard fromBit = squareBit(from);
+            Bitboard toBit = squareBit(to);
+
+            // the squares seen from both ends, with the other end as only blocker
+            if (rookAttacks(from, 0) & toBit) {
+                betweenTable[from][to] = rookAttacks(from, toBit) & rookAttacks(to, fromBit);
+            } else if (bishopAttacks(from, 0) & toBit) {
+                betweenTable[from][to] = bishopAttacks(from, toBit) & bishopAttacks(to, fromBit);
+            } else {
+                betweenTable[from][to] = 0;
+            }
+        }
+    }
+}
+
+static bool buildTables() {
+    initLeapers();
+    usePext = cpuHasBmi2();
+    initSlider(rookMagics, rookMultipliers, rookTable, rookDirections);
+    initSlider(bishopMagics, bishopMultipliers, bishopTable, bishopDirections);
+    initBetween();
+    return true;
+}
+
+void initAttacks() {
+    // built once, even if several threads ask for it at the same time
+    static bool built = buildTables();
+    (void) built;
+}
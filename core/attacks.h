@@ -0,0 +1,156 @@
+/**
+ * @file attacks.h
+ * @brief Header file for the precomputed attack tables of the pieces
+ */
+
+#ifndef ATTACKS_H
+#define ATTACKS_H
+
+#include "bitboard.h"
+#include "pieces.h"
+
+using namespace std;
+
+/**
+ * @struct Magic
+ * @brief Data needed to index the attack table of a sliding piece on one square
+*/
+struct Magic {
+    Bitboard mask;      ///< relevant occupancy squares (the rays without the board edges)
+    Bitboard magic;     ///< multiplier mapping the masked occupancy to an index
+    Bitboard* attacks;  ///< first entry of the attack table of the square
+    int shift;          ///< 64 minus the number of relevant squares
+};
+
+extern Magic rookMagics[64];
+extern Magic bishopMagics[64];
+
+extern Bitboard knightTable[64];
+extern Bitboard kingTable[64];
+extern Bitboard pawnTable[2][64];
+extern Bitboard betweenTable[64][64];
+
+/**
+ * @brief true if the tables are indexed with the BMI2 PEXT instruction instead of the magic multiplication
+*/
+extern bool usePext;
+
+/**
+ * @brief Build the attack tables, choosing PEXT if the CPU supports BMI2, safe to call several times
+*/
+void initAttacks();
+
+/**
+ * @brief Compute the table index of an occupancy with the PEXT instruction, only called if usePext is set
+ *
+ * The instruction is written in assembly rather than with the intrinsic, which would need the whole program to be
+ * built for BMI2: the lookups are inlined in the move generation while the choice stays made at runtime.
+ * @param occupancy The occupancy of the board
+ * @param mask The relevant occupancy squares
+ * @return The index in the attack table
+*/
+inline unsigned pextIndex(Bitboard occupancy, Bitboard mask) {
+#if defined(__x86_64__)
+    Bitboard index;
+    asm("pextq %2, %1, %0" : "=r"(index) : "r"(occupancy), "r"(mask));
+    return unsigned(index);
+#else
+    (void)occupancy;
+    (void)mask;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Compute the table index of an occupancy for a square
+ * @param entry The magic entry of the square
+ * @param occupancy The occupancy of the board
+ * @return The index in the attack table of the square
+*/
+inline unsigned magicIndex(const Magic & entry, Bitboard occupancy) {
+    if (usePext) {
+        return pextIndex(occupancy, entry.mask);
+    }
+
+    return unsigned(((occupancy & entry.mask) * entry.magic) >> entry.shift);
+}
+
+// ------------------------------------------------
+//              LEAPING ATTACKS
+// ------------------------------------------------
+
+/**
+ * @brief Get the squares attacked by a knight
+ * @param square The square of the knight
+ * @return The attacked squares
+*/
+inline Bitboard knightAttacks(int square) {
+    return knightTable[square];
+}
+
+/**
+ * @brief Get the squares attacked by a king
+ * @param square The square of the king
+ * @return The attacked squares
+*/
+inline Bitboard kingAttacks(int square) {
+    return kingTable[square];
+}
+
+/**
+ * @brief Get the squares attacked (diagonally) by a pawn
+ * @param color The color of the pawn
+ * @param square The square of the pawn
+ * @return The attacked squares
+*/
+inline Bitboard pawnAttacks(Color color, int square) {
+    return pawnTable[colorIndex(color)][square];
+}
+
+/**
+ * @brief Get the squares strictly between two squares on the same line, column or diagonal
+ * @param from The first square
+ * @param to The second square
+ * @return The squares between them, empty if they are not aligned
+*/
+inline Bitboard betweenSquares(int from, int to) {
+    return betweenTable[from][to];
+}
+
+// ------------------------------------------------
+//              SLIDING ATTACKS
+// ------------------------------------------------
+
+/**
+ * @brief Get the squares attacked by a rook
+ * @param square The square of the rook
+ * @param occupancy The occupancy of the board
+ * @return The attacked squares, including the first blocker of each ray
+*/
+inline Bitboard rookAttacks(int square, Bitboard occupancy) {
+    const Magic & entry = rookMagics[square];
+    return entry.attacks[magicIndex(entry, occupancy)];
+}
+
+/**
+ * @brief Get the squares attacked by a bishop
+ * @param square The square of the bishop
+ * @param occupancy The occupancy of the board
+ * @return The attacked squares, including the first blocker of each ray
+*/
+inline Bitboard bishopAttacks(int square, Bitboard occupancy) {
+    const Magic & entry = bishopMagics[square];
+    return entry.attacks[magicIndex(entry, occupancy)];
+}
+
+/**
+ * @brief Get the squares attacked by a queen
+ * @param square The square of the queen
+ * @param occupancy The occupancy of the board
+ * @return The attacked squares, including the first blocker of each ray
+*/
+inline Bitboard queenAttacks(int square, Bitboard occupancy) {
+    return rookAttacks(square, occupancy) | bishopAttacks(square, occupancy);
+}
+
+#endif
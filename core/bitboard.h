@@ -0,0 +1,92 @@
+/**
+ * @file bitboard.h
+ * @brief Header file for the 64-bit bitboard type and its helpers
+ */
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @brief A set of squares, one bit per square (a1 = bit 0, h8 = bit 63)
+*/
+typedef uint64_t Bitboard;
+
+// ------------------------------------------------
+//                SQUARE INDEXES
+// ------------------------------------------------
+
+/**
+ * @brief Get the index (0-63) of a square
+ * @param line The line of the square (0-7)
+ * @param column The column of the square (0-7)
+ * @return The index of the square
+*/
+inline int squareIndex(int line, int column) {
+    return line * 8 + column;
+}
+
+/**
+ * @brief Get the line (0-7) of a square index
+ * @param square The index of the square
+ * @return The line of the square
+*/
+inline int squareLine(int square) {
+    return square >> 3;
+}
+
+/**
+ * @brief Get the column (0-7) of a square index
+ * @param square The index of the square
+ * @return The column of the square
+*/
+inline int squareColumn(int square) {
+    return square & 7;
+}
+
+// ------------------------------------------------
+//                 BIT HELPERS
+// ------------------------------------------------
+
+/**
+ * @brief Get the bitboard with only one square set
+ * @param square The index of the square
+ * @return The bitboard of the square
+*/
+inline Bitboard squareBit(int square) {
+    return Bitboard(1) << square;
+}
+
+/**
+ * @brief Get the index of the least significant set bit
+ * @param bitboard A non empty bitboard
+ * @return The index of the first square of the bitboard
+*/
+inline int lsb(Bitboard bitboard) {
+    return __builtin_ctzll(bitboard);
+}
+
+/**
+ * @brief Remove the least significant set bit and return its index
+ * @param bitboard A non empty bitboard, modified in place
+ * @return The index of the removed square
+*/
+inline int popLsb(Bitboard & bitboard) {
+    int square = lsb(bitboard);
+    bitboard &= bitboard - 1;
+    return square;
+}
+
+/**
+ * @brief Count the number of set bits
+ * @param bitboard The bitboard
+ * @return The number of squares in the bitboard
+*/
+inline int popCount(Bitboard bitboard) {
+    return __builtin_popcountll(bitboard);
+}
+
+#endif
@@ -5,22 +5,24 @@
 
 #include "board.h"
 
+#include <iomanip>
+
 // ------------------------------------------------
 //          PATTERN MATCHING FUNCTIONS
 // ------------------------------------------------
 
 bool correctMovementPattern(string const & cmd) {
-    regex mouvementPattern("[a-h][1-8][a-h][1-8]");
+    static const regex mouvementPattern("[a-h][1-8][a-h][1-8]");
     return regex_match(cmd, mouvementPattern);
 }
 
 bool correctKingsideCastlingPattern(string const & cmd) {
-    regex kingsideCastlingPattern("(O|o|0)-(O|o|0)");
+    static const regex kingsideCastlingPattern("(O|o|0)-(O|o|0)");
     return regex_match(cmd, kingsideCastlingPattern);
 }
 
 bool correctQueensideCastlingPattern(string const & cmd) {
-    regex queensideCastlingPattern("(O|o|0)-(O|o|0)-(O|o|0)");
+    static const regex queensideCastlingPattern("(O|o|0)-(O|o|0)-(O|o|0)");
     return regex_match(cmd, queensideCastlingPattern);
 }
 
@@ -28,691 +30,472 @@ bool correctQueensideCastlingPattern(string const & cmd) {
 //                 MOVE PIECES
 // ------------------------------------------------
 
-bool Board::checkPawnMove(Piece* pawn, Piece* endPiece, Square start, Square end) {
-    // ----- WHITE PAWN LOGIC -----
-    if (pawn->getColor() == Color::WHITE) {
-        if (start.getColumn() == end.getColumn()) {
-            // pawn is moving forward by one square
-            if (
-                end.getLine() == start.getLine() + 1 &&
-                endPiece == nullptr
-            ) {
-                return true;
-            }
-
-            // pawn is moving forward by two squares from the initial position
-            if (
-                start.getLine() + 1 == 2 &&
-                end.getLine() == start.getLine() + 2 &&
-                endPiece == nullptr &&
-                board[end.getLine() - 1][end.getColumn()] == nullptr
-            ) {
-                possibleEnPassant = true;
-                return true;
-            }
-        } else {
-            // pawn is capturing a piece
-            if (
-                endPiece != nullptr &&
-                end.getLine() == start.getLine() + 1 &&
-                abs(end.getColumn() - start.getColumn()) == 1 &&
-                endPiece->getColor() != pawn->getColor()
-            ) {
-                return true;
-            }
+void Board::placePiece(int line, int column, Piece piece) {
+    int square = squareIndex(line, column);
 
-            // pawn is capturing a piece using en passant move
-            if (
-                possibleEnPassant &&
-                endPiece == nullptr &&
-                end.getLine() == start.getLine() + 1 &&
-                abs(end.getColumn() - start.getColumn()) == 1 &&
-                board[start.getLine()][end.getColumn()] != nullptr &&
-                board[start.getLine()][end.getColumn()]->getPsymb() == 'P' &&
-                board[start.getLine()][end.getColumn()]->getColor() != pawn->getColor()
-            ) {
-                return true;
-            }
+    if (!board[line][column].isEmpty()) {
+        Color color = board[line][column].getColor();
+        PieceType type = board[line][column].getType();
+        position.removePiece(color, type, square);
+        hashKey ^= pieceKey(color, type, square);
+        if (type == PieceType::PAWN) {
+            pawnKey ^= pieceKey(color, type, square);
+        }
+        stageScores[MIDDLEGAME] -= pieceSquareScore(MIDDLEGAME, color, type, square);
+        stageScores[ENDGAME] -= pieceSquareScore(ENDGAME, color, type, square);
+        gamePhase -= phaseWeight(type);
 
+        if (networkLoaded) {
+            updateNetworkInput(board[line][column], square, false);
         }
+    }
 
-        return false;
-    } 
+    board[line][column] = piece;
 
-    // ----- BLACK PAWN LOGIC -----
+    if (!piece.isEmpty()) {
+        position.addPiece(piece.getColor(), piece.getType(), square);
+        hashKey ^= pieceKey(piece.getColor(), piece.getType(), square);
+        if (piece.getType() == PieceType::PAWN) {
+            pawnKey ^= pieceKey(piece.getColor(), piece.getType(), square);
+        }
+        stageScores[MIDDLEGAME] += pieceSquareScore(MIDDLEGAME, piece.getColor(), piece.getType(), square);
+        stageScores[ENDGAME] += pieceSquareScore(ENDGAME, piece.getColor(), piece.getType(), square);
+        gamePhase += phaseWeight(piece.getType());
 
-    if (start.getColumn() == end.getColumn()) {
-        // pawn is moving forward by one square
-        if (
-            end.getLine() == start.getLine() - 1 &&
-            endPiece == nullptr
-        ) {
-            return true;
+        if (piece.getPsymb() == 'K') {
+            kingSquares[colorIndex(piece.getColor())] = square;
         }
 
-        // pawn is moving forward by two squares from the initial position
-        if (
-            start.getLine() + 1 == 7 &&
-            end.getLine() == start.getLine() - 2 &&
-            endPiece == nullptr &&
-            board[end.getLine() + 1][end.getColumn()] == nullptr
-        ) {
-            possibleEnPassant = true;
-            return true;
+        if (networkLoaded) {
+            updateNetworkInput(piece, square, true);
         }
-    } else {
-        // pawn is capturing a piece
-        if (
-            endPiece != nullptr &&
-            end.getLine() == start.getLine() - 1 &&
-            abs(end.getColumn() - start.getColumn()) == 1 &&
-            endPiece->getColor() != pawn->getColor()
-        ) {
-            return true;
+    }
+}
+
+void Board::updateNetworkInput(Piece piece, int square, bool added) {
+    // the inputs of a perspective depend on the square of its king, they are all computed again at the next evaluation
+    if (piece.getType() == PieceType::KING) {
+        accumulator.dirty[colorIndex(piece.getColor())] = true;
+        return;
+    }
+
+    for (Color perspective : {Color::WHITE, Color::BLACK}) {
+        if (accumulator.dirty[colorIndex(perspective)]) {
+            continue;
         }
 
-        // pawn is capturing a piece using en passant move
-        if (
-            possibleEnPassant &&
-            endPiece == nullptr &&
-            end.getLine() == start.getLine() - 1 &&
-            abs(end.getColumn() - start.getColumn()) == 1 &&
-            board[start.getLine()][end.getColumn()] != nullptr &&
-            board[start.getLine()][end.getColumn()]->getPsymb() == 'P' &&
-            board[start.getLine()][end.getColumn()]->getColor() != pawn->getColor()
-        ) {
-            return true;
+        int input = networkInput(perspective, kingSquares[colorIndex(perspective)], piece.getColor(), piece.getType(), square);
+        if (added) {
+            addInput(accumulator, perspective, input);
+        } else {
+            removeInput(accumulator, perspective, input);
         }
     }
+}
 
-    return false;
+void Board::placePiece(int square, Piece piece) {
+    placePiece(squareLine(square), squareColumn(square), piece);
 }
 
-bool Board::checkRookMove(Piece* rook, Piece* endPiece, Square start, Square end) {
-    // rook is moving vertically
-    if (start.getColumn() == end.getColumn()) {
-        // rook is moving up
-        if (end.getLine() > start.getLine()) {
-            for (int i = start.getLine() + 1; i < end.getLine(); i++) {
-                if (board[i][end.getColumn()] != nullptr) {
-                    return false;
-                }
-            }
+/**
+ * @brief Castling rights kept when a piece leaves or reaches each square
+*/
+static int castlingMask(int square) {
+    switch (square) {
+        case 0: return ~WHITE_QUEENSIDE;
+        case 4: return ~(WHITE_KINGSIDE | WHITE_QUEENSIDE);
+        case 7: return ~WHITE_KINGSIDE;
+        case 56: return ~BLACK_QUEENSIDE;
+        case 60: return ~(BLACK_KINGSIDE | BLACK_QUEENSIDE);
+        case 63: return ~BLACK_KINGSIDE;
+        default: return ~0;
+    }
+}
 
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != rook->getColor()
-            ) {
-                return true;
-            }
+void Board::makeMove(Move move) {
+    int from = move.getFrom();
+    int to = move.getTo();
+    Piece moved = board[squareLine(from)][squareColumn(from)];
 
-            return false;
-        }
+    // the pawn taken en passant is beside the start square
+    int captureSquare = move.getKind() == MoveKind::EN_PASSANT ? squareIndex(squareLine(from), squareColumn(to)) : to;
+    Piece captured = board[squareLine(captureSquare)][squareColumn(captureSquare)];
 
-        // rook is moving down
-        if (end.getLine() < start.getLine()) {
-            for (int i = start.getLine() - 1; i > end.getLine(); i--) {
-                if (board[i][end.getColumn()] != nullptr) {
-                    return false;
-                }
-            }
+    undoStack.push_back({move, moved, captured, castlingRights, enPassantSquare, nbMovesWithoutTaking});
+    keyHistory.push_back(hashKey);
 
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != rook->getColor()
-            ) {
-                return true;
-            }
+    // the pieces are hashed by placePiece, the other features are replaced by their new value
+    hashKey ^= enPassantHash() ^ castlingKey(castlingRights);
 
-            return false;
-        }
+    if (!captured.isEmpty() || moved.getPsymb() == 'P') {
+        nbMovesWithoutTaking = 0;
+    } else {
+        nbMovesWithoutTaking += 1;
     }
 
-    // rook is moving horizontally
-    if (start.getLine() == end.getLine()) {
-        // rook is moving right
-        if (end.getColumn() > start.getColumn()) {
-            for (int i = start.getColumn() + 1; i < end.getColumn(); i++) {
-                if (board[end.getLine()][i] != nullptr) {
-                    return false;
-                }
-            }
+    // move the piece, replaced by the chosen piece for a promotion
+    placePiece(captureSquare, Piece());
+    placePiece(from, Piece());
+    placePiece(to, move.getKind() == MoveKind::PROMOTION ? Piece(moved.getColor(), move.getPromotion()) : moved);
+
+    // the rook jumps over the king when castling
+    if (move.getKind() == MoveKind::CASTLING) {
+        int rookFrom = to > from ? from + 3 : from - 4;
+        int rookTo = to > from ? from + 1 : from - 1;
+        placePiece(rookTo, board[squareLine(rookFrom)][squareColumn(rookFrom)]);
+        placePiece(rookFrom, Piece());
+    }
 
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != rook->getColor()
-            ) {
-                return true;
-            }
+    // a pawn moving forward by two squares can be captured en passant on the next move
+    if (moved.getPsymb() == 'P' && abs(to - from) == 16) {
+        enPassantSquare = (from + to) / 2;
+    } else {
+        enPassantSquare = -1;
+    }
 
-            return false;
-        }
+    castlingRights &= castlingMask(from) & castlingMask(to);
+    changePlayer();
+    hashKey ^= enPassantHash() ^ castlingKey(castlingRights);
+}
 
-        // rook is moving left
-        if (end.getColumn() < start.getColumn()) {
-            for (int i = start.getColumn() - 1; i > end.getColumn(); i--) {
-                if (board[end.getLine()][i] != nullptr) {
-                    return false;
-                }
-            }
+void Board::unmakeMove() {
+    UndoRecord record = undoStack.back();
+    undoStack.pop_back();
 
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != rook->getColor()
-            ) {
-                return true;
-            }
+    int from = record.move.getFrom();
+    int to = record.move.getTo();
 
-            return false;
-        }
+    if (record.move.getKind() == MoveKind::CASTLING) {
+        int rookFrom = to > from ? from + 3 : from - 4;
+        int rookTo = to > from ? from + 1 : from - 1;
+        placePiece(rookFrom, board[squareLine(rookTo)][squareColumn(rookTo)]);
+        placePiece(rookTo, Piece());
     }
 
-    return false;
-}
-
-bool Board::checkKnightMove(Piece* knight, Piece* endPiece, Square start, Square end) {
-    if (
-        (abs(end.getLine() - start.getLine()) == 2 && abs(end.getColumn() - start.getColumn()) == 1) ||
-        (abs(end.getLine() - start.getLine()) == 1 && abs(end.getColumn() - start.getColumn()) == 2)
-    ) {
-        if (
-            endPiece == nullptr ||
-            endPiece->getColor() != knight->getColor()
-        ) {
-            return true;
-        }
+    placePiece(to, Piece());
+    placePiece(from, record.moved);
 
-        return false;
+    if (!record.captured.isEmpty()) {
+        int captureSquare = record.move.getKind() == MoveKind::EN_PASSANT ? squareIndex(squareLine(from), squareColumn(to)) : to;
+        placePiece(captureSquare, record.captured);
     }
 
-    return false;
+    castlingRights = record.castlingRights;
+    enPassantSquare = record.enPassantSquare;
+    nbMovesWithoutTaking = record.nbMovesWithoutTaking;
+    changePlayer();
+
+    hashKey = keyHistory.back();
+    keyHistory.pop_back();
 }
 
-bool Board::checkBishopMove(Piece* bishop, Piece* endPiece, Square start, Square end) {
-    // bishop is moving diagonally
-    if (abs(end.getLine() - start.getLine()) == abs(end.getColumn() - start.getColumn())) {
-        // bishop is moving up-right
-        if (end.getLine() > start.getLine() && end.getColumn() > start.getColumn()) {
-            for (int i = 1; i < end.getLine() - start.getLine(); i++) {
-                if (board[start.getLine() + i][start.getColumn() + i] != nullptr) {
-                    return false;
-                }
-            }
+// ------------------------------------------------
+//                    HASHING
+// ------------------------------------------------
 
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != bishop->getColor()
-            ) {
-                return true;
-            }
+HashKey Board::enPassantHash() const {
+    if (enPassantSquare == -1) {
+        return 0;
+    }
 
-            return false;
-        }
+    // a pawn of the player to move attacks the square if a pawn of the other color would attack it from there
+    Color side = isWhitePlaying ? Color::WHITE : Color::BLACK;
+    if (!(pawnAttacks(opponent(side), enPassantSquare) & position.getPieces(side, PieceType::PAWN))) {
+        return 0;
+    }
 
-        // bishop is moving up-left
-        if (end.getLine() > start.getLine() && end.getColumn() < start.getColumn()) {
-            for (int i = 1; i < end.getLine() - start.getLine(); i++) {
-                if (board[start.getLine() + i][start.getColumn() - i] != nullptr) {
-                    return false;
-                }
-            }
+    return enPassantKey(squareColumn(enPassantSquare));
+}
 
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != bishop->getColor()
-            ) {
-                return true;
-            }
+HashKey Board::computeHashKey() const {
+    HashKey key = 0;
 
-            return false;
+    for (int square = 0; square < 64; square++) {
+        Piece piece = board[squareLine(square)][squareColumn(square)];
+        if (!piece.isEmpty()) {
+            key ^= pieceKey(piece.getColor(), piece.getType(), square);
         }
+    }
 
-        // bishop is moving down-right
-        if (end.getLine() < start.getLine() && end.getColumn() > start.getColumn()) {
-            for (int i = 1; i < start.getLine() - end.getLine(); i++) {
-                if (board[start.getLine() - i][start.getColumn() + i] != nullptr) {
-                    return false;
-                }
-            }
+    if (!isWhitePlaying) {
+        key ^= zobristBlackToMove;
+    }
 
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != bishop->getColor()
-            ) {
-                return true;
-            }
+    return key ^ castlingKey(castlingRights) ^ enPassantHash();
+}
 
-            return false;
-        }
+HashKey Board::getHashKey() const {
+    return hashKey;
+}
 
-        // bishop is moving down-left
-        if (end.getLine() < start.getLine() && end.getColumn() < start.getColumn()) {
-            for (int i = 1; i < start.getLine() - end.getLine(); i++) {
-                if (board[start.getLine() - i][start.getColumn() - i] != nullptr) {
-                    return false;
-                }
-            }
+HashKey Board::getPawnKey() const {
+    return pawnKey;
+}
 
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != bishop->getColor()
-            ) {
-                return true;
-            }
+bool Board::isRepetition(int times) const {
+    // only the positions with the same player to move and no capture or pawn move since can be the same
+    int count = 1;
+    int size = keyHistory.size();
+    int oldest = max(0, size - nbMovesWithoutTaking);
 
-            return false;
+    for (int i = size - 2; i >= oldest; i -= 2) {
+        if (keyHistory[i] == hashKey && ++count == times) {
+            return true;
         }
     }
 
     return false;
 }
 
-bool Board::checkQueenMove(Piece* queen, Piece* endPiece, Square start, Square end) {
-    // queen is moving vertically
-    if (start.getColumn() == end.getColumn()) {
-        // queen is moving up
-        if (end.getLine() > start.getLine()) {
-            for (int i = start.getLine() + 1; i < end.getLine(); i++) {
-                if (board[i][end.getColumn()] != nullptr) {
-                    return false;
-                }
-            }
-
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != queen->getColor()
-            ) {
-                return true;
-            }
-
-            return false;
-        }
-
-        // queen is moving down
-        if (end.getLine() < start.getLine()) {
-            for (int i = start.getLine() - 1; i > end.getLine(); i--) {
-                if (board[i][end.getColumn()] != nullptr) {
-                    return false;
-                }
-            }
+bool Board::isThreefoldRepetition() const {
+    return isRepetition(3);
+}
 
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != queen->getColor()
-            ) {
-                return true;
-            }
+// ------------------------------------------------
+//                  EVALUATION
+// ------------------------------------------------
 
-            return false;
-        }
-    }
+int Board::getStageScore(Stage stage) const {
+    return stageScores[stage];
+}
 
-    // queen is moving horizontally
-    if (start.getLine() == end.getLine()) {
-        // queen is moving right
-        if (end.getColumn() > start.getColumn()) {
-            for (int i = start.getColumn() + 1; i < end.getColumn(); i++) {
-                if (board[end.getLine()][i] != nullptr) {
-                    return false;
-                }
-            }
+int Board::getGamePhase() const {
+    return gamePhase;
+}
 
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != queen->getColor()
-            ) {
-                return true;
-            }
+PawnEntry Board::analyzePawns() const {
+    return analyzePawnStructure(position, pawnKey);
+}
 
-            return false;
+int Board::evaluateWithNetwork() const {
+    for (Color perspective : {Color::WHITE, Color::BLACK}) {
+        if (!accumulator.dirty[colorIndex(perspective)]) {
+            continue;
         }
 
-        // queen is moving left
-        if (end.getColumn() < start.getColumn()) {
-            for (int i = start.getColumn() - 1; i > end.getColumn(); i--) {
-                if (board[end.getLine()][i] != nullptr) {
-                    return false;
+        int inputs[32];
+        int count = 0;
+        for (Color color : {Color::WHITE, Color::BLACK}) {
+            for (int type = 0; type < 5; type++) {
+                Bitboard pieces = position.getPieces(color, static_cast<PieceType>(type));
+                while (pieces && count < 32) {
+                    inputs[count++] = networkInput(perspective, kingSquares[colorIndex(perspective)], color, static_cast<PieceType>(type), popLsb(pieces));
                 }
             }
-
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != queen->getColor()
-            ) {
-                return true;
-            }
-
-            return false;
         }
+        refreshAccumulator(accumulator, perspective, inputs, count);
     }
 
-    // queen is moving diagonally
-    if (abs(end.getLine() - start.getLine()) == abs(end.getColumn() - start.getColumn())) {
-        // queen is moving up-right
-        if (end.getLine() > start.getLine() && end.getColumn() > start.getColumn()) {
-            for (int i = 1; i < end.getLine() - start.getLine(); i++) {
-                if (board[start.getLine() + i][start.getColumn() + i] != nullptr) {
-                    return false;
-                }
-            }
-
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != queen->getColor()
-            ) {
-                return true;
-            }
-
-            return false;
-        }
-
-        // queen is moving up-left
-        if (end.getLine() > start.getLine() && end.getColumn() < start.getColumn()) {
-            for (int i = 1; i < end.getLine() - start.getLine(); i++) {
-                if (board[start.getLine() + i][start.getColumn() - i] != nullptr) {
-                    return false;
-                }
-            }
+    return evaluateNetwork(accumulator, getSideToMove());
+}
 
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != queen->getColor()
-            ) {
-                return true;
-            }
+// ------------------------------------------------
+//                 POSITION SETUP
+// ------------------------------------------------
 
-            return false;
-        }
+bool Board::loadFen(const string & fen) {
+    istringstream stream(fen);
+    string placement, side, castling, enPassant;
+    int halfmoveClock = 0;
+    stream >> placement >> side >> castling >> enPassant;
+    if (!(stream >> halfmoveClock)) {
+        halfmoveClock = 0;
+    }
 
-        // queen is moving down-right
-        if (end.getLine() < start.getLine() && end.getColumn() > start.getColumn()) {
-            for (int i = 1; i < start.getLine() - end.getLine(); i++) {
-                if (board[start.getLine() - i][start.getColumn() + i] != nullptr) {
-                    return false;
-                }
+    // start from an empty board
+    for (int square = 0; square < 64; square++) {
+        placePiece(square, Piece());
+    }
+    kingSquares[0] = kingSquares[1] = -1;
+    undoStack.clear();
+    keyHistory.clear();
+    castlingRights = 0;
+    enPassantSquare = -1;
+    nbMovesWithoutTaking = 0;
+    isWhitePlaying = true;
+    isPlaying = true;
+    whiteWin = false;
+    blackWin = false;
+    hashKey = 0;
+    pawnKey = 0;
+    stageScores[MIDDLEGAME] = stageScores[ENDGAME] = 0;
+    gamePhase = 0;
+    accumulator.dirty[0] = accumulator.dirty[1] = true;
+
+    // the lines are given from the 8th to the 1st, each one from column a to h
+    static const string symbols = "PNBRQK";
+    int line = 7;
+    int column = 0;
+    for (char c : placement) {
+        if (c == '/') {
+            // each line has its 8 columns
+            if (column != 8 || line == 0) {
+                return false;
             }
-
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != queen->getColor()
-            ) {
-                return true;
+            line--;
+            column = 0;
+        } else if (c >= '1' && c <= '8') {
+            column += c - '0';
+            if (column > 8) {
+                return false;
             }
-
-            return false;
-        }
-
-        // queen is moving down-left
-        if (end.getLine() < start.getLine() && end.getColumn() < start.getColumn()) {
-            for (int i = 1; i < start.getLine() - end.getLine(); i++) {
-                if (board[start.getLine() - i][start.getColumn() - i] != nullptr) {
-                    return false;
-                }
+        } else {
+            size_t type = symbols.find(toupper(c));
+            if (type == string::npos || line < 0 || column > 7) {
+                return false;
             }
-
-            if (
-                endPiece == nullptr ||
-                endPiece->getColor() != queen->getColor()
-            ) {
-                return true;
+            // a pawn can't stand on the first or the last line, it would have been promoted
+            if (type == 0 && (line == 0 || line == 7)) {
+                return false;
             }
-
-            return false;
+            placePiece(line, column++, Piece(isupper(c) ? Color::WHITE : Color::BLACK, static_cast<PieceType>(type)));
         }
     }
 
-    return false;
-}
-
-bool Board::checkKingMove(Piece* king, Piece* endPiece, Square start, Square end) {
-    // king is moving vertically
-    if (abs(end.getLine() - start.getLine()) == 1 && abs(end.getColumn() - start.getColumn()) == 0) {
-        if (
-            endPiece == nullptr ||
-            endPiece->getColor() != king->getColor()
-        ) {
-            return true;
-        }
+    // the 8 lines are given, and each player has one king
+    if (line != 0 || column != 8) {
+        return false;
+    }
+    if (
+        popCount(position.getPieces(Color::WHITE, PieceType::KING)) != 1 ||
+        popCount(position.getPieces(Color::BLACK, PieceType::KING)) != 1
+    ) {
+        return false;
+    }
 
+    if (side != "w" && side != "b") {
         return false;
     }
+    isWhitePlaying = side == "w";
+
+    for (char c : castling) {
+        switch (c) {
+            case 'K': castlingRights |= WHITE_KINGSIDE; break;
+            case 'Q': castlingRights |= WHITE_QUEENSIDE; break;
+            case 'k': castlingRights |= BLACK_KINGSIDE; break;
+            case 'q': castlingRights |= BLACK_QUEENSIDE; break;
+            case '-': break;
+            default: return false;
+        }
+    }
 
-    // king is moving horizontally
-    if (abs(end.getColumn() - start.getColumn()) == 1 && abs(end.getLine() - start.getLine()) == 0) {
+    // a right is only kept if the king and the rook are still on their squares, as the move generation expects
+    static const int rightSquares[4][2] = {{4, 7}, {4, 0}, {60, 63}, {60, 56}};
+    for (int right = 0; right < 4; right++) {
+        Color color = right < 2 ? Color::WHITE : Color::BLACK;
         if (
-            endPiece == nullptr ||
-            endPiece->getColor() != king->getColor()
+            !(position.getPieces(color, PieceType::KING) & squareBit(rightSquares[right][0])) ||
+            !(position.getPieces(color, PieceType::ROOK) & squareBit(rightSquares[right][1]))
         ) {
-            return true;
+            castlingRights &= ~(1 << right);
         }
-
-        return false;
     }
 
-    // king is moving diagonally
-    if (abs(end.getLine() - start.getLine()) == 1 && abs(end.getColumn() - start.getColumn()) == 1) {
+    if (enPassant.size() == 2 && enPassant[0] >= 'a' && enPassant[0] <= 'h' && enPassant[1] >= '1' && enPassant[1] <= '8') {
+        enPassantSquare = Square(enPassant.c_str()).getIndex();
+
+        // the square was just crossed by a pawn of the opponent, which stands behind it
+        Color them = isWhitePlaying ? Color::BLACK : Color::WHITE;
+        int passedLine = isWhitePlaying ? 5 : 2;
+        int pawnSquare = enPassantSquare + (isWhitePlaying ? -8 : 8);
         if (
-            endPiece == nullptr ||
-            endPiece->getColor() != king->getColor()
+            squareLine(enPassantSquare) != passedLine ||
+            position.isOccupied(enPassantSquare) ||
+            !(position.getPieces(them, PieceType::PAWN) & squareBit(pawnSquare))
         ) {
-            return true;
+            return false;
         }
-
+    } else if (enPassant != "-") {
         return false;
     }
 
-    // king is castling kingside -> TODO
-    if (end.getColumn() - start.getColumn() == 2) {
-        return false;
-    }
+    nbMovesWithoutTaking = halfmoveClock;
+    hashKey = computeHashKey();
+    return true;
+}
 
-    // king is castling queenside -> TODO
-    if (start.getColumn() - end.getColumn() == 2) {
-        return false;
-    }
+// ------------------------------------------------
+//                 MOVE GENERATION
+// ------------------------------------------------
 
-    return false;
+const Position & Board::getPosition() const {
+    return position;
 }
 
-bool Board::checkPieceMove(Piece* piece, Square start, Square end) {
-    Piece* endPiece = board[end.getLine()][end.getColumn()];
-
-    // ----- PAWN LOGIC -----
-    if (piece->getPsymb() == 'P')
-        return checkPawnMove(piece, endPiece, start, end);
+Piece Board::getPiece(int square) const {
+    return board[squareLine(square)][squareColumn(square)];
+}
 
-    // ----- ROOK LOGIC -----
-    if (piece->getPsymb() == 'R')
-        return checkRookMove(piece, endPiece, start, end);
+Move Board::getLastMove() const {
+    return undoStack.empty() ? Move() : undoStack.back().move;
+}
 
-    // ----- KNIGHT LOGIC -----
-    if (piece->getPsymb() == 'N')
-        return checkKnightMove(piece, endPiece, start, end);
+Color Board::getSideToMove() const {
+    return isWhitePlaying ? Color::WHITE : Color::BLACK;
+}
 
-    // ----- BISHOP LOGIC -----
-    if (piece->getPsymb() == 'B')
-        return checkBishopMove(piece, endPiece, start, end);
+int Board::getHalfmoveClock() const {
+    return nbMovesWithoutTaking;
+}
 
-    // ----- QUEEN LOGIC -----
-    if (piece->getPsymb() == 'Q')
-        return checkQueenMove(piece, endPiece, start, end);
+int Board::getCastlingRights() const {
+    return castlingRights;
+}
 
-    // ----- KING LOGIC -----
-    if (piece->getPsymb() == 'K')
-        return checkKingMove(piece, endPiece, start, end);
+void Board::generateLegalMoves(MoveList & moves, bool isWhitePlaying) const {
+    ::generateLegalMoves(position, isWhitePlaying ? Color::WHITE : Color::BLACK, getCastlingRights(), enPassantSquare, moves);
+}
 
-    return false;
+void Board::generateLegalMoves(MoveList & moves) const {
+    generateLegalMoves(moves, isWhitePlaying);
 }
 
 // ------------------------------------------------
 //               CHECK & CHECKMATE
 // ------------------------------------------------
 
-string Board::findKingPosition(bool isWhitePlaying) {
-    string kingPosition = "";
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            if (board[i][j] != nullptr && board[i][j]->getPsymb() == 'K' && board[i][j]->getColor() == (isWhitePlaying ? Color::WHITE : Color::BLACK)) {
-                kingPosition = board[i][j]->getPosition();
-            }
-        }
-    }
+int Board::findKingPosition(bool isWhitePlaying) const {
+    return kingSquares[colorIndex(isWhitePlaying ? Color::WHITE : Color::BLACK)];
+}
 
-    return kingPosition;
+bool Board::isSquareAttacked(int square, Color byColor) const {
+    return position.isSquareAttacked(square, byColor);
 }
 
-bool Board::isCheck(bool isWhitePlaying) {
-    // Récupérer la position du roi
-    string kingPosition = findKingPosition(isWhitePlaying);
-    
-    // Créer un objet Square pour la position du roi
-    Square kingSquare(&kingPosition[0]);
-
-    // Parcourir le tableau pour trouver les pièces adverses
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            if (
-                board[i][j] != nullptr &&
-                board[i][j]->getColor() != (isWhitePlaying ? Color::WHITE : Color::BLACK)
-            ) {
-                // Créer un objet Square pour la position de la pièce adverse
-                Square opponentPiece(&board[i][j]->getPosition()[0]);
-
-                // Vérifier si la pièce adverse peut capturer le roi
-                if (checkPieceMove(board[i][j], opponentPiece, kingSquare)) {
-                    // cout << board[i][j]->getPsymb() << " en " << board[i][j]->getPosition() << " peut capturer le roi " << (isWhitePlaying ? "blanc" : "noir") << " en " << kingPosition << endl;
-                    return true;
-                }
-            }
-        }
+bool Board::isCheck(bool isWhitePlaying) const {
+    int kingPosition = findKingPosition(isWhitePlaying);
+    if (kingPosition == -1) {
+        return false;
     }
 
-    return false;
+    return isSquareAttacked(kingPosition, isWhitePlaying ? Color::BLACK : Color::WHITE);
 }
 
 bool Board::isCheckmate(bool isWhitePlaying) {
-    // get the king position
-    string kingPosition = findKingPosition(isWhitePlaying);
-
-    // get the king square
-    Square kingSquare(&kingPosition[0]);
-    Piece* king = board[kingSquare.getLine()][kingSquare.getColumn()];
-
-    // check if the king can move around it's position
-    // and see if it's still in check
-    // taking in consideration the limits of the board
-    for (int i = -1; i <= 1; i++) {
-        for (int j = -1; j <= 1; j++) {
-            if (
-                (i != 0 || j != 0) &&
-                kingSquare.getLine() + i >= 0 && kingSquare.getLine() + i < 8 &&
-                kingSquare.getColumn() + j >= 0 && kingSquare.getColumn() + j < 8 &&
-                (board[kingSquare.getLine() + i][kingSquare.getColumn() + j] == nullptr ||
-                board[kingSquare.getLine() + i][kingSquare.getColumn() + j]->getColor() != king->getColor())
-            ) {
-                // try to move the king
-                Piece* endPiece = board[kingSquare.getLine() + i][kingSquare.getColumn() + j];
-
-                board[kingSquare.getLine() + i][kingSquare.getColumn() + j] = king;
-                string endPosition = string(1, 'a' + kingSquare.getColumn() + j) + to_string(kingSquare.getLine() + i + 1);
-                board[kingSquare.getLine() + i][kingSquare.getColumn() + j]->setPosition(endPosition);
-                board[kingSquare.getLine()][kingSquare.getColumn()] = nullptr;
-
-                if (!isCheck(isWhitePlaying)) {
-                    board[kingSquare.getLine()][kingSquare.getColumn()] = king;
-                    board[kingSquare.getLine() + i][kingSquare.getColumn() + j] = endPiece;
-                    board[kingSquare.getLine()][kingSquare.getColumn()]->setPosition(kingPosition);
-                    if (endPiece != nullptr) {
-                        board[kingSquare.getLine() + i][kingSquare.getColumn() + j]->setPosition(endPiece->getPosition());
-                    }
-                    return false;
-                }
-
-                board[kingSquare.getLine()][kingSquare.getColumn()] = king;
-                board[kingSquare.getLine() + i][kingSquare.getColumn() + j] = endPiece;
-                board[kingSquare.getLine()][kingSquare.getColumn()]->setPosition(kingPosition);
-                if (endPiece != nullptr) {
-                    board[kingSquare.getLine() + i][kingSquare.getColumn() + j]->setPosition(endPiece->getPosition());
-                }
-            }
-        }
-    }
-
-    // check if any piece can move to protect the king
-    // and see if the king is still in check
-    bool saveEnPassant = possibleEnPassant;
-
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            // find a piece of the same color
-            if (
-                board[i][j] != nullptr &&
-                board[i][j]->getColor() == (isWhitePlaying ? Color::WHITE : Color::BLACK) &&
-                board[i][j]->getPsymb() != 'K'
-            ) {
-                // verify if a possible move exists
-                for (int k = 0; k < 8; k++) {
-                    for (int l = 0; l < 8; l++) {
-                        string startPosition = string(1, 'a' + j) + to_string(i + 1);
-                        string endPosition = string(1, 'a' + l) + to_string(k + 1);
-                        if (checkPieceMove(board[i][j], Square(&startPosition[0]), Square(&endPosition[0]))) {
-                            // try to move the piece
-                            Piece* endPiece = board[k][l];
-
-                            board[k][l] = board[i][j];
-                            board[k][l]->setPosition(endPosition);
-                            board[i][j] = nullptr;
-
-                            if (!isCheck(isWhitePlaying)) {
-                                board[i][j] = board[k][l];
-                                board[k][l] = endPiece;
-                                board[i][j]->setPosition(startPosition);
-                                if (endPiece != nullptr) {
-                                    board[k][l]->setPosition(endPiece->getPosition());
-                                }
-                                possibleEnPassant = saveEnPassant;
-                                return false;
-                            }
-
-                            board[i][j] = board[k][l];
-                            board[k][l] = endPiece;
-                            board[i][j]->setPosition(startPosition);
-                            if (endPiece != nullptr) {
-                                board[k][l]->setPosition(endPiece->getPosition());
-                            }
-                        }
-                    }
-                }
-            }
-        }
+    if (!isCheck(isWhitePlaying)) {
+        return false;
     }
 
-    return true;
+    // the king is in check and no legal move can protect it
+    MoveList moves;
+    generateLegalMoves(moves, isWhitePlaying);
+    return moves.empty();
 }
 
 bool Board::isStalemate(bool isWhitePlaying) {
-
     // check if this is a triple repetition of the position
-    // for the 2 players
-    bool whiteFlagRepeat = 
-        lastMovesWhite[0] != "" &&
-        lastMovesWhite[0] == lastMovesWhite[2] &&
-        lastMovesWhite[2] == lastMovesWhite[4] &&
-        lastMovesWhite[1] == lastMovesWhite[3]
-    ;
-
-    bool blackFlagRepeat =
-        lastMovesBlack[0] != "" &&
-        lastMovesBlack[0] == lastMovesBlack[2] &&
-        lastMovesBlack[2] == lastMovesBlack[4] &&
-        lastMovesBlack[1] == lastMovesBlack[3]
-    ;
-
-    return
-        ((!isCheck(isWhitePlaying) && isCheckmate(isWhitePlaying)) &&
-        nbMovesWithoutTaking < 50) ||
-        (whiteFlagRepeat && blackFlagRepeat)
-    ;
+    if (isThreefoldRepetition()) {
+        return true;
+    }
+
+    if (isCheck(isWhitePlaying) || nbMovesWithoutTaking >= 50) {
+        return false;
+    }
+
+    // the king is not in check but the player has no legal move
+    MoveList moves;
+    generateLegalMoves(moves, isWhitePlaying);
+    return moves.empty();
 }
 
 // ------------------------------------------------
@@ -721,96 +504,70 @@ bool Board::isStalemate(bool isWhitePlaying) {
 
 void Board::initGame() {
     // ----- position setup for the pieces -----
-    board[0][0] = new Rook(Color::WHITE, 1, "a1");
-    board[0][1] = new Knight(Color::WHITE, 2, "b1");
-    board[0][2] = new Bishop(Color::WHITE, 3, "c1");
-    board[0][3] = new Queen(Color::WHITE, 4, "d1");
-    board[0][4] = new King(Color::WHITE, 5, "e1");
-    board[0][5] = new Bishop(Color::WHITE, 6, "f1");
-    board[0][6] = new Knight(Color::WHITE, 7, "g1");
-    board[0][7] = new Rook(Color::WHITE, 8, "h1");
-
-    board[7][0] = new Rook(Color::BLACK, 9, "a8");
-    board[7][1] = new Knight(Color::BLACK, 10, "b8");
-    board[7][2] = new Bishop(Color::BLACK, 11, "c8");
-    board[7][3] = new Queen(Color::BLACK, 12, "d8");
-    board[7][4] = new King(Color::BLACK, 13, "e8");
-    board[7][5] = new Bishop(Color::BLACK, 14, "f8");
-    board[7][6] = new Knight(Color::BLACK, 15, "g8");
-    board[7][7] = new Rook(Color::BLACK, 16, "h8");
-
-    for (int i = 0; i < 8; i++) {
-        char column = 'a' + i; // Convertir l'indice en caractère ASCII ('a' + i)
-        board[1][i] = new Pawn(Color::WHITE, i + 17, string(1, column) + "2");
-        board[6][i] = new Pawn(Color::BLACK, i + 25, string(1, column) + "7");
-    }
-
-    for (int i = 2; i < 6; i++)
-        for (int j = 0; j < 8; j++)
-            board[i][j] = nullptr;
+    loadFen(STARTING_FEN);
 
     // ----- Begin the game logic -----
     game();
 }
 
 void Board::showBoard() {
-    cout << endl;
-    cout << white << bold;
-    cout << "\t     a   b   c   d   e   f   g   h  \n";
-    cout << "\t   ┌───┬───┬───┬───┬───┬───┬───┬───┐\n";
+    *outputStream << endl;
+    *outputStream << white << bold;
+    *outputStream << "\t     a   b   c   d   e   f   g   h  \n";
+    *outputStream << "\t   ┌───┬───┬───┬───┬───┬───┬───┬───┐\n";
     for (int i = 0; i < 7; i++) {
-        cout << "\t" << 8 - i << "  │";
+        *outputStream << "\t" << 8 - i << "  │";
         for (int j = 0; j < 7; j++) {
-            cout << " ";
-            if (board[7 - i][j] == nullptr) {
-                cout << "  │";
+            *outputStream << " ";
+            if (board[7 - i][j].isEmpty()) {
+                *outputStream << "  │";
             } else {
-                cout << board[7 - i][j]->getIcon() << " │";
+                *outputStream << board[7 - i][j].getIcon() << " │";
             }
             
         }
         
-        cout << " ";
-        if (board[7 - i][7] == nullptr) {
-            cout << "  │";
+        *outputStream << " ";
+        if (board[7 - i][7].isEmpty()) {
+            *outputStream << "  │";
         } else {
-            cout << board[7 - i][7]->getIcon() << " │";
+            *outputStream << board[7 - i][7].getIcon() << " │";
         }
-        cout << endl;
-        cout << "\t   ├───┼───┼───┼───┼───┼───┼───┼───┤\n";
+        *outputStream << endl;
+        *outputStream << "\t   ├───┼───┼───┼───┼───┼───┼───┼───┤\n";
     }
-    cout << "\t1  │";
+    *outputStream << "\t1  │";
     for (int i = 0; i < 7; i++) {
-        cout << " ";
-        if (board[0][i] == nullptr) {
-            cout << "  │";
+        *outputStream << " ";
+        if (board[0][i].isEmpty()) {
+            *outputStream << "  │";
         } else {
-            cout << board[0][i]->getIcon() << " │";
+            *outputStream << board[0][i].getIcon() << " │";
         }
     }
-    cout << " ";
-    if (board[0][7] == nullptr) {
-        cout << "  │";
+    *outputStream << " ";
+    if (board[0][7].isEmpty()) {
+        *outputStream << "  │";
     } else {
-        cout << board[0][7]->getIcon() << " │";
+        *outputStream << board[0][7].getIcon() << " │";
     }
-    cout << endl;
-    cout << "\t   └───┴───┴───┴───┴───┴───┴───┴───┘\n";
-    cout << "\t     a   b   c   d   e   f   g   h  \n";
-    cout << endl;
+    *outputStream << endl;
+    *outputStream << "\t   └───┴───┴───┴───┴───┴───┴───┴───┘\n";
+    *outputStream << "\t     a   b   c   d   e   f   g   h  \n";
+    *outputStream << endl;
     
 }
 
 string Board::canonical_position() const {
+    const char* symbols[64] = {};
+    position.fillSymbols(symbols);
+
     string output = "";
-    for (size_t row(0); row <= 7; row++){
-        for (char col('a'); col <= 'h'; col++) {
-            if (board[row][col - 'a'] != nullptr) {
-                output += (board[row][col - 'a']->getColor() == Color::WHITE ? "w" : "b");
-                output += board[row][col - 'a']->getPsymb();
-            }
-            output += ",";
+    for (int square = 0; square < 64; square++) {
+        if (symbols[square] != nullptr) {
+            output += symbols[square];
         }
+        output += ",";
     }
 
     if (whiteWin) {
@@ -828,261 +585,206 @@ string Board::canonical_position() const {
 
 string Board::getInput(bool isWhitePlaying) {
     string input;
-    cout << endl;
-    cout << blue << bold;
+    *outputStream << endl;
+    *outputStream << blue << bold;
     if (isWhitePlaying) {
-        cout << "Aux blancs de jouer." << endl;
+        *outputStream << "Aux blancs de jouer." << endl;
     } else {
-        cout << "Aux noirs de jouer." << endl;
+        *outputStream << "Aux noirs de jouer." << endl;
     }
-    cout << white << bold;
-    cout << "🕹️  Entrez votre coup: ";
-    cout << orange;
-    cin >> input;
-    cout << reset << endl;
+    *outputStream << white << bold;
+    *outputStream << "🕹️  Entrez votre coup: ";
+    *outputStream << orange;
+    if (!(*inputStream >> input)) {
+        input = "/quit";
+    }
+    *outputStream << reset << endl;
 
     return input;
 }
 
 bool Board::validMove(string input, bool isWhitePlaying) {
-    Square start(&input[0]);
-    Square end(&input[2]);
+    Move move;
+    return validMove(input, isWhitePlaying, move);
+}
+
+bool Board::validMove(string input, bool isWhitePlaying, Move & move) {
+    Square start(input.c_str());
+    Square end(input.c_str() + 2);
 
     // get the piece at the initial position
-    Piece* piece = board[start.getLine()][start.getColumn()];
+    Piece piece = board[start.getLine()][start.getColumn()];
 
     // check if there is a piece at the initial position
-    if (piece == nullptr) {
+    if (piece.isEmpty()) {
         invelidMoveReason = "Il n'y a pas de pièce à cet endroit.";
         return false;
     }
 
     // check if the piece is the right color
-    if ((isWhitePlaying && piece->getColor() == Color::BLACK) || (!isWhitePlaying && piece->getColor() == Color::WHITE)) {
+    if ((isWhitePlaying && piece.getColor() == Color::BLACK) || (!isWhitePlaying && piece.getColor() == Color::WHITE)) {
         invelidMoveReason = "Vous ne pouvez pas jouer cette pièce.";
         return false;
     }
 
     // check if the end is the start
-    if (start.toString() == end.toString()) {
+    if (start == end) {
         invelidMoveReason = "Vous devez déplacer la pièce.";
         return false;
     }
 
-    // check if the Piece can move to the end position
-    if (!checkPieceMove(piece, start, end)) {
-        invelidMoveReason = "Ce mouvement n'est pas valide.";
-        return false;
+    // look for the move among the legal moves, castling is only played with its own command
+    MoveList moves;
+    generateLegalMoves(moves, isWhitePlaying);
+    for (Move legalMove : moves) {
+        if (
+            legalMove.getFrom() == start.getIndex() &&
+            legalMove.getTo() == end.getIndex() &&
+            legalMove.getKind() != MoveKind::CASTLING
+        ) {
+            move = legalMove;
+            return true;
+        }
     }
 
-    // check if the move doesn't put the king in check
-    // we save the current state of squares, try the move, check if the king is in check, and then revert the move
-    Piece* startPiece = board[start.getLine()][start.getColumn()];
-    Piece* endPiece = board[end.getLine()][end.getColumn()];
-
-    board[end.getLine()][end.getColumn()] = board[start.getLine()][start.getColumn()];
-    board[end.getLine()][end.getColumn()]->setPosition(end.toString());
-    board[start.getLine()][start.getColumn()] = nullptr;
-
-    if (isCheck(isWhitePlaying)) {
-        invelidMoveReason = "Le roi ";
-        invelidMoveReason += isWhitePlaying ? "blanc" : "noir";
-        invelidMoveReason += " est en échec.";
-        board[start.getLine()][start.getColumn()] = startPiece;
-        board[end.getLine()][end.getColumn()] = endPiece;
-        board[start.getLine()][start.getColumn()]->setPosition(start.toString());
-        return false;
+    // the move follows the piece pattern but leaves the king in check
+    MoveList pseudoLegalMoves;
+    generatePseudoLegalMoves(position, isWhitePlaying ? Color::WHITE : Color::BLACK, getCastlingRights(), enPassantSquare, pseudoLegalMoves);
+    for (Move pseudoLegalMove : pseudoLegalMoves) {
+        if (
+            pseudoLegalMove.getFrom() == start.getIndex() &&
+            pseudoLegalMove.getTo() == end.getIndex() &&
+            pseudoLegalMove.getKind() != MoveKind::CASTLING
+        ) {
+            invelidMoveReason = "Le roi ";
+            invelidMoveReason += isWhitePlaying ? "blanc" : "noir";
+            invelidMoveReason += " est en échec.";
+            return false;
+        }
     }
 
-    board[start.getLine()][start.getColumn()] = startPiece;
-    board[end.getLine()][end.getColumn()] = endPiece;
-    
-    return true;
+    invelidMoveReason = "Ce mouvement n'est pas valide.";
+    return false;
 }
 
 bool Board::validKingSideCastling(bool isWhitePlaying) {
+    int line = isWhitePlaying ? 0 : 7;
+    Color color = isWhitePlaying ? Color::WHITE : Color::BLACK;
+
     // verify if the king and the rook are in position
     if (
-        board[isWhitePlaying ? 0 : 7][4] == nullptr ||
-        board[isWhitePlaying ? 0 : 7][7] == nullptr ||
-        board[isWhitePlaying ? 0 : 7][4]->getPsymb() != 'K' ||
-        board[isWhitePlaying ? 0 : 7][7]->getPsymb() != 'R'
+        board[line][4].isEmpty() ||
+        board[line][7].isEmpty() ||
+        board[line][4].getPsymb() != 'K' ||
+        board[line][7].getPsymb() != 'R' ||
+        board[line][4].getColor() != color ||
+        board[line][7].getColor() != color
     ) {
-        cout << red << bold;
-        cout << "🚫 Le roi ou la tour n'est pas en position." << endl;
-        cout << reset;
+        *outputStream << red << bold;
+        *outputStream << "🚫 Le roi ou la tour n'est pas en position." << endl;
+        *outputStream << reset;
         return false;
     }
 
-    // find the king and the rook positions
-    Square kingSquare(&board[isWhitePlaying ? 0 : 7][4]->getPosition()[0]);
-    Square rookSquare(&board[isWhitePlaying ? 0 : 7][7]->getPosition()[0]);
-
-    // get the king and the rook
-    Piece* king = board[kingSquare.getLine()][kingSquare.getColumn()];
-    Piece* rook = board[rookSquare.getLine()][rookSquare.getColumn()];
-
     // check if the king and the rook haven't moved
-    if (king->getHasMoved() || rook->getHasMoved()) {
-        cout << red << bold;
-        cout << "🚫 Le roi ou la tour a déjà bougé." << endl;
-        cout << reset;
+    if (!(castlingRights & (isWhitePlaying ? WHITE_KINGSIDE : BLACK_KINGSIDE))) {
+        *outputStream << red << bold;
+        *outputStream << "🚫 Le roi ou la tour a déjà bougé." << endl;
+        *outputStream << reset;
         return false;
     }
 
     // check if the squares between the king and the rook are empty
-    if (
-        board[rookSquare.getLine()][rookSquare.getColumn() - 1] != nullptr ||
-        board[rookSquare.getLine()][rookSquare.getColumn() - 2] != nullptr
-    ) {
-        cout << red << bold;
-        cout << "🚫 Les cases entre le roi et la tour ne sont pas vides." << endl;
-        cout << reset;
+    if (!board[line][5].isEmpty() || !board[line][6].isEmpty()) {
+        *outputStream << red << bold;
+        *outputStream << "🚫 Les cases entre le roi et la tour ne sont pas vides." << endl;
+        *outputStream << reset;
         return false;
     }
 
     // check if the king is not in check
     if (isCheck(isWhitePlaying)) {
-        cout << red << bold;
-        cout << "🚫 Le roi " << (isWhitePlaying ? "blanc" : "noir") << " est en échec." << endl;
-        cout << reset;
+        *outputStream << red << bold;
+        *outputStream << "🚫 Le roi " << (isWhitePlaying ? "blanc" : "noir") << " est en échec." << endl;
+        *outputStream << reset;
         return false;
     }
 
     // check if the king doesn't pass through a square that is attacked by an opponent piece
-    // we do it by trying to move the king to the squares between the king and the rook
-    // if the king is in check after the move, the castling is not valid
-
-    // move the king to the first square
-    board[kingSquare.getLine()][kingSquare.getColumn() + 1] = king;
-    board[kingSquare.getLine()][kingSquare.getColumn()] = nullptr;
-    board[kingSquare.getLine()][kingSquare.getColumn() + 1]->setPosition((isWhitePlaying? "f1" : "f8"));
-
-    if (isCheck(isWhitePlaying)) {
-        cout << red << bold;
-        cout << "🚫 Une des cases du roc est attaquée" << endl;
-        cout << reset;
-        board[kingSquare.getLine()][kingSquare.getColumn() + 1] = nullptr;
-        board[kingSquare.getLine()][kingSquare.getColumn()] = king;
-        board[kingSquare.getLine()][kingSquare.getColumn()]->setPosition((isWhitePlaying? "e1" : "e8"));
-        return false;
-    }
-
-    // move the king to the second square
-    board[kingSquare.getLine()][kingSquare.getColumn() + 2] = king;
-    board[kingSquare.getLine()][kingSquare.getColumn() + 1] = nullptr;
-    board[kingSquare.getLine()][kingSquare.getColumn() + 2]->setPosition((isWhitePlaying? "g1" : "g8"));
-
-    if (isCheck(isWhitePlaying)) {
-        cout << red << bold;
-        cout << "🚫 Une des cases du roc est attaquée" << endl;
-        cout << reset;
-        board[kingSquare.getLine()][kingSquare.getColumn() + 2] = nullptr;
-        board[kingSquare.getLine()][kingSquare.getColumn()] = king;
-        board[kingSquare.getLine()][kingSquare.getColumn()]->setPosition((isWhitePlaying? "e1" : "e8"));
-        return false;
+    for (int column = 5; column <= 6; column++) {
+        if (isSquareAttacked(squareIndex(line, column), opponent(color))) {
+            *outputStream << red << bold;
+            *outputStream << "🚫 Une des cases du roc est attaquée" << endl;
+            *outputStream << reset;
+            return false;
+        }
     }
 
-    // move the king back to the initial position
-    board[kingSquare.getLine()][kingSquare.getColumn()] = king;
-    board[kingSquare.getLine()][kingSquare.getColumn() + 2] = nullptr;
-    board[kingSquare.getLine()][kingSquare.getColumn()]->setPosition((isWhitePlaying? "e1" : "e8"));
-
     return true;
 }
 
 bool Board::validQueenSideCastling(bool isWhitePlaying) {
-    // find the king and the rook positions
-    Square kingSquare(&board[isWhitePlaying ? 0 : 7][4]->getPosition()[0]);
-    Square rookSquare(&board[isWhitePlaying ? 0 : 7][0]->getPosition()[0]);
-
-    // get the king and the rook
-    Piece* king = board[kingSquare.getLine()][kingSquare.getColumn()];
-    Piece* rook = board[rookSquare.getLine()][rookSquare.getColumn()];
-
-    if (rook == nullptr) {
-        cout << red << bold;
-        cout << "🚫 La tour n'est pas en position." << endl;
-        cout << reset;
+    int line = isWhitePlaying ? 0 : 7;
+    Color color = isWhitePlaying ? Color::WHITE : Color::BLACK;
+
+    // verify if the king and the rook are in position
+    if (
+        board[line][4].isEmpty() ||
+        board[line][0].isEmpty() ||
+        board[line][4].getPsymb() != 'K' ||
+        board[line][0].getPsymb() != 'R' ||
+        board[line][4].getColor() != color ||
+        board[line][0].getColor() != color
+    ) {
+        *outputStream << red << bold;
+        *outputStream << "🚫 La tour n'est pas en position." << endl;
+        *outputStream << reset;
         return false;
     }
 
     // check if the king and the rook haven't moved
-    if (king->getHasMoved() || rook->getHasMoved()) {
-        cout << red << bold;
-        cout << "🚫 Le roi ou la tour a déjà bougé." << endl;
-        cout << reset;
+    if (!(castlingRights & (isWhitePlaying ? WHITE_QUEENSIDE : BLACK_QUEENSIDE))) {
+        *outputStream << red << bold;
+        *outputStream << "🚫 Le roi ou la tour a déjà bougé." << endl;
+        *outputStream << reset;
         return false;
     }
 
     // check if the squares between the king and the rook are empty
-    if (
-        board[rookSquare.getLine()][rookSquare.getColumn() + 1] != nullptr ||
-        board[rookSquare.getLine()][rookSquare.getColumn() + 2] != nullptr ||
-        board[rookSquare.getLine()][rookSquare.getColumn() + 3] != nullptr
-    ) {
-        cout << red << bold;
-        cout << "🚫 Les cases entre le roi et la tour ne sont pas vides." << endl;
-        cout << reset;
+    if (!board[line][1].isEmpty() || !board[line][2].isEmpty() || !board[line][3].isEmpty()) {
+        *outputStream << red << bold;
+        *outputStream << "🚫 Les cases entre le roi et la tour ne sont pas vides." << endl;
+        *outputStream << reset;
         return false;
     }
 
     // check if the king is not in check
     if (isCheck(isWhitePlaying)) {
-        cout << red << bold;
-        cout << "🚫 Le roi " << (isWhitePlaying ? "blanc" : "noir") << " est en échec." << endl;
-        cout << reset;
+        *outputStream << red << bold;
+        *outputStream << "🚫 Le roi " << (isWhitePlaying ? "blanc" : "noir") << " est en échec." << endl;
+        *outputStream << reset;
         return false;
     }
 
     // check if the king doesn't pass through a square that is attacked by an opponent piece
-    // we do it by trying to move the king to the squares between the king and the rook
-    // if the king is in check after the move, the castling is not valid
-
-    // move the king to the first square
-    board[kingSquare.getLine()][kingSquare.getColumn() - 1] = king;
-    board[kingSquare.getLine()][kingSquare.getColumn()] = nullptr;
-    board[kingSquare.getLine()][kingSquare.getColumn() - 1]->setPosition((isWhitePlaying? "d1" : "d8"));
-
-    if (isCheck(isWhitePlaying)) {
-        cout << red << bold;
-        cout << "🚫 Une des cases du roc est attaquée" << endl;
-        cout << reset;
-        board[kingSquare.getLine()][kingSquare.getColumn() - 1] = nullptr;
-        board[kingSquare.getLine()][kingSquare.getColumn()] = king;
-        board[kingSquare.getLine()][kingSquare.getColumn()]->setPosition((isWhitePlaying? "e1" : "e8"));
-        return false;
-    }
-
-    // move the king to the second square
-    board[kingSquare.getLine()][kingSquare.getColumn() - 2] = king;
-    board[kingSquare.getLine()][kingSquare.getColumn() - 1] = nullptr;
-    board[kingSquare.getLine()][kingSquare.getColumn() - 2]->setPosition((isWhitePlaying? "c1" : "c8"));
-
-    if (isCheck(isWhitePlaying)) {
-        cout << red << bold;
-        cout << "🚫 Une des cases du roc est attaquée" << endl;
-        cout << reset;
-        board[kingSquare.getLine()][kingSquare.getColumn() - 2] = nullptr;
-        board[kingSquare.getLine()][kingSquare.getColumn()] = king;
-        board[kingSquare.getLine()][kingSquare.getColumn()]->setPosition((isWhitePlaying? "e1" : "e8"));
-        return false;
+    for (int column = 3; column >= 2; column--) {
+        if (isSquareAttacked(squareIndex(line, column), opponent(color))) {
+            *outputStream << red << bold;
+            *outputStream << "🚫 Une des cases du roc est attaquée" << endl;
+            *outputStream << reset;
+            return false;
+        }
     }
 
-    // move the king back to the initial position
-    board[kingSquare.getLine()][kingSquare.getColumn()] = king;
-    board[rookSquare.getLine()][rookSquare.getColumn() + 3] = nullptr;
-    board[kingSquare.getLine()][kingSquare.getColumn()]->setPosition((isWhitePlaying? "e1" : "e8"));
-
     return true;
 }
 
 void Board::resignGame() {
-    cout << endl;
-    cout << blue;
-    cout << "Abandon de la partie par les ";
-    cout << bold << (isWhitePlaying ? "blancs" : "noirs") << ".";
-    cout << endl;
+    *outputStream << endl;
+    *outputStream << blue;
+    *outputStream << "Abandon de la partie par les ";
+    *outputStream << bold << (isWhitePlaying ? "blancs" : "noirs") << ".";
+    *outputStream << endl;
 
     isPlaying = false;
     if (isWhitePlaying) {
@@ -1097,118 +799,76 @@ void Board::drawGame() {
 }
 
 void Board::endGame() {
-    cout << endl;
-    cout << white << bold;
-    cout << "🏁 Fin de la partie." << endl;
-    cout << endl;
+    *outputStream << endl;
+    *outputStream << white << bold;
+    *outputStream << "🏁 Fin de la partie." << endl;
+    *outputStream << endl;
 
     if (whiteWin) {
-        cout << "🎉 Les blancs ont gagné." << endl;
+        *outputStream << "🎉 Les blancs ont gagné." << endl;
     } else if (blackWin) {
-        cout << "🎉 Les noirs ont gagné." << endl;
+        *outputStream << "🎉 Les noirs ont gagné." << endl;
     } else {
-        cout << "🤝 Match nul." << endl;
+        *outputStream << "🤝 Match nul." << endl;
     }
 
-    cout << endl;
+    *outputStream << endl;
 
 }
 
 void Board::changePlayer() {
     isWhitePlaying = !isWhitePlaying;
+    hashKey ^= zobristBlackToMove;
 }
 
 bool Board::processNormalMove(string input) {
-    // save the possible en passant before valid move modifies it
-    bool savePossibleEnPassant = possibleEnPassant;
     invelidMoveReason = "";
 
     // verify if the move is valid
-    if (!validMove(input, isWhitePlaying)) {
-        cout << red << bold;
-        cout << "🚫 " << invelidMoveReason << endl;
-        cout << reset;
+    Move move;
+    if (!validMove(input, isWhitePlaying, move)) {
+        *outputStream << red << bold;
+        *outputStream << "🚫 " << invelidMoveReason << endl;
+        *outputStream << reset;
         return false;
     }
-    
-    // move the piece
-    Square start(&input[0]);
-    Square end(&input[2]);
-
-    if (board[end.getLine()][end.getColumn()] != nullptr) {
-        nbMovesWithoutTaking = 0;
-    } else {
-        nbMovesWithoutTaking += 1;
-    }
-
-    board[end.getLine()][end.getColumn()] = board[start.getLine()][start.getColumn()];
-    board[start.getLine()][start.getColumn()] = nullptr;
-    board[end.getLine()][end.getColumn()]->setPosition(end.toString());
-    board[end.getLine()][end.getColumn()]->setHasMoved();
 
     // Promotion
-    if (board[end.getLine()][end.getColumn()]->getPsymb() == 'P' && end.getLine() == (isWhitePlaying ? 7 : 0)) {
-        cout << "♟️ Promotion de pion: ";
-        cout << "Choisissez la pièce de promotion (Queen(Q), Rook(R), Bishop(B), Knight(N)): ";
+    if (move.getKind() == MoveKind::PROMOTION) {
+        *outputStream << "♟️ Promotion de pion: ";
+        *outputStream << "Choisissez la pièce de promotion (Queen(Q), Rook(R), Bishop(B), Knight(N)): ";
         string promotion;
-        cin >> promotion;
-        while (promotion != "Q" && promotion != "R" && promotion != "B" && promotion != "N") {
-            cout << "🚫 Choix invalide, veuillez réessayer: ";
-            cin >> promotion;
+        *inputStream >> promotion;
+        while (*inputStream && promotion != "Q" && promotion != "R" && promotion != "B" && promotion != "N") {
+            *outputStream << "🚫 Choix invalide, veuillez réessayer: ";
+            *inputStream >> promotion;
         }
 
-        if (promotion == "Q") {
-            board[end.getLine()][end.getColumn()] = new Queen(isWhitePlaying ? Color::WHITE : Color::BLACK, 0, end.toString());
-        } else if (promotion == "R") {
-            board[end.getLine()][end.getColumn()] = new Rook(isWhitePlaying ? Color::WHITE : Color::BLACK, 0, end.toString());
+        PieceType type = PieceType::QUEEN;
+        if (promotion == "R") {
+            type = PieceType::ROOK;
         } else if (promotion == "B") {
-            board[end.getLine()][end.getColumn()] = new Bishop(isWhitePlaying ? Color::WHITE : Color::BLACK, 0, end.toString());
+            type = PieceType::BISHOP;
         } else if (promotion == "N") {
-            board[end.getLine()][end.getColumn()] = new Knight(isWhitePlaying ? Color::WHITE : Color::BLACK, 0, end.toString());
-        }
-    }
-
-    // handle en passant
-    if (savePossibleEnPassant) {
-        if (
-            board[end.getLine()][end.getColumn()]->getPsymb() == 'P' &&
-            abs(end.getLine() - start.getLine()) == 1 &&
-            abs(end.getColumn() - start.getColumn()) == 1
-        ) {
-            board[start.getLine()][end.getColumn()] = nullptr;
+            type = PieceType::KNIGHT;
         }
 
-        possibleEnPassant = false;
+        move = Move(move.getFrom(), move.getTo(), MoveKind::PROMOTION, type);
     }
 
+    // move the piece
+    makeMove(move);
+
     return true;
 }
 
 bool Board::processKingsideCastlingMove() {
     if (!validKingSideCastling(isWhitePlaying))
         return false;
-        
-    // find the king and the rook positions
-    Square kingSquare(&board[isWhitePlaying ? 0 : 7][4]->getPosition()[0]);
-    Square rookSquare(&board[isWhitePlaying ? 0 : 7][7]->getPosition()[0]);
-
-    // get the king and the rook
-    Piece* king = board[kingSquare.getLine()][kingSquare.getColumn()];
-    Piece* rook = board[rookSquare.getLine()][rookSquare.getColumn()];
 
     // move the king and the rook
-    board[rookSquare.getLine()][rookSquare.getColumn() - 1] = king;
-    board[rookSquare.getLine()][rookSquare.getColumn() - 2] = rook;
-    board[kingSquare.getLine()][kingSquare.getColumn()] = nullptr;
-    board[rookSquare.getLine()][rookSquare.getColumn()] = nullptr;
-
-    // update the positions
-    board[rookSquare.getLine()][rookSquare.getColumn() - 1]->setPosition((isWhitePlaying? "g1" : "g8"));
-    board[rookSquare.getLine()][rookSquare.getColumn() - 2]->setPosition((isWhitePlaying? "f1" : "f8"));
-    board[rookSquare.getLine()][rookSquare.getColumn() - 1]->setHasMoved();
-    board[rookSquare.getLine()][rookSquare.getColumn() - 2]->setHasMoved();
-
-    nbMovesWithoutTaking += 1;
+    int kingSquare = squareIndex(isWhitePlaying ? 0 : 7, 4);
+    makeMove(Move(kingSquare, kingSquare + 2, MoveKind::CASTLING));
 
     return true;
 }
@@ -1217,32 +877,17 @@ bool Board::processQueensideCastlingMove() {
     if (!validQueenSideCastling(isWhitePlaying))
         return false;
 
-    // find the king and the rook positions
-    Square kingSquare(&board[isWhitePlaying ? 0 : 7][4]->getPosition()[0]);
-    Square rookSquare(&board[isWhitePlaying ? 0 : 7][0]->getPosition()[0]);
-
-    // get the king and the rook
-    Piece* king = board[kingSquare.getLine()][kingSquare.getColumn()];
-    Piece* rook = board[rookSquare.getLine()][rookSquare.getColumn()];
-
     // move the king and the rook
-    board[kingSquare.getLine()][kingSquare.getColumn() - 2] = king;
-    board[kingSquare.getLine()][kingSquare.getColumn() - 1] = rook;
-    board[kingSquare.getLine()][kingSquare.getColumn()] = nullptr;
-    board[rookSquare.getLine()][rookSquare.getColumn()] = nullptr;
-
-    // update the positions
-    board[kingSquare.getLine()][kingSquare.getColumn() - 2]->setPosition((isWhitePlaying? "c1" : "c8"));
-    board[kingSquare.getLine()][kingSquare.getColumn() - 1]->setPosition((isWhitePlaying? "d1" : "d8"));
-    board[kingSquare.getLine()][kingSquare.getColumn() - 2]->setHasMoved();
-    board[kingSquare.getLine()][kingSquare.getColumn() - 1]->setHasMoved();
-
-    nbMovesWithoutTaking += 1;
+    int kingSquare = squareIndex(isWhitePlaying ? 0 : 7, 4);
+    makeMove(Move(kingSquare, kingSquare - 2, MoveKind::CASTLING));
 
     return true;
 }
 
 bool Board::processMove(string input) {
+    // the turn goes to the other player once the move is played
+    bool isWhiteMoving = isWhitePlaying;
+
     if (correctMovementPattern(input)) {
         if (!processNormalMove(input)){
             // invalid move
@@ -1261,28 +906,31 @@ bool Board::processMove(string input) {
     }
     else
     {
-        cout << red << bold;
-        cout << "🚫 Commande invalide, veuillez réessayer (tapez "; 
-        cout << orange << "/help" << red;
-        cout << " pour voir les coups valides)." << endl;
-        cout << reset;
+        *outputStream << red << bold;
+        *outputStream << "🚫 Commande invalide, veuillez réessayer (tapez "; 
+        *outputStream << orange << "/help" << red;
+        *outputStream << " pour voir les coups valides)." << endl;
+        *outputStream << reset;
         return false;
     }
 
     // IF THE MOVE IS DONE 
+    return concludeMove(input, isWhiteMoving);
+}
 
-    cout << "✅ Mouvement " << input << " effectué." << endl;
-    cout << reset;
+bool Board::concludeMove(string input, bool isWhiteMoving) {
+    *outputStream << "✅ Mouvement " << input << " effectué." << endl;
+    *outputStream << reset;
 
     // check if the other player is in check
-    if (isCheck(!isWhitePlaying)) {
-        if (isCheckmate(!isWhitePlaying)) {
-            cout << red << bold;
-            cout << "👑 Échec et mat pour les " << (!isWhitePlaying ? "blancs" : "noirs")<< endl;
-            cout << reset;
+    if (isCheck(!isWhiteMoving)) {
+        if (isCheckmate(!isWhiteMoving)) {
+            *outputStream << red << bold;
+            *outputStream << "👑 Échec et mat pour les " << (!isWhiteMoving ? "blancs" : "noirs")<< endl;
+            *outputStream << reset;
 
             isPlaying = false;
-            if (isWhitePlaying) {
+            if (isWhiteMoving) {
                 whiteWin = true;
             } else {
                 blackWin = true;
@@ -1291,42 +939,103 @@ bool Board::processMove(string input) {
             return false;
 
         } else {
-            cout << red << bold;
-            cout << "⚔️ Ce mouvement met le roi " << (!isWhitePlaying ? "blanc" : "noir") << " en échec." << endl;
-            cout << reset;
+            *outputStream << red << bold;
+            *outputStream << "⚔️ Ce mouvement met le roi " << (!isWhiteMoving ? "blanc" : "noir") << " en échec." << endl;
+            *outputStream << reset;
         }
     }
 
     // check if the other player is in stalemate
-    if (isStalemate(!isWhitePlaying)) {
-        cout << blue << bold;
-        cout << "💤 Pat." << endl;
-        cout << reset;
+    if (isStalemate(!isWhiteMoving)) {
+        *outputStream << blue << bold;
+        *outputStream << "💤 Pat." << endl;
+        *outputStream << reset;
 
         isPlaying = false;
     }
 
-    // save the last inputs in the table of the 5 last moves
-    // in order to determine if this is a Stalemate by repetition
-    if (isWhitePlaying) {
-        for (int i = 4; i > 0; i--) {
-            lastMovesWhite[i] = lastMovesWhite[i - 1];
-        }
-        lastMovesWhite[0] = input;
+    return true;
+}
+
+void Board::setStreams(istream & input, ostream & output, bool render) {
+    inputStream = &input;
+    outputStream = &output;
+    rendering = render;
+}
+
+bool Board::isGameOver() const {
+    return !isPlaying;
+}
+
+void Board::setEnginePlayers(bool whiteEngine, bool blackEngine, const SearchLimits & limits, size_t hashMegabytes) {
+    enginePlayers[colorIndex(Color::WHITE)] = whiteEngine;
+    enginePlayers[colorIndex(Color::BLACK)] = blackEngine;
+    engineLimits = limits;
+
+    if (whiteEngine || blackEngine) {
+        engineTable = make_shared<TranspositionTable>(hashMegabytes);
+        enginePawnTables = make_shared<vector<PawnTable>>();
+    }
+}
+
+bool Board::playEngineMove() {
+    bool isWhiteMoving = isWhitePlaying;
+
+    *outputStream << endl;
+    *outputStream << blue << bold;
+    *outputStream << "🤖 L'ordinateur réfléchit pour les " << (isWhiteMoving ? "blancs" : "noirs") << "..." << endl;
+    *outputStream << reset;
+
+    SearchResult result = searchBestMove(*this, engineLimits, engineTable.get(), enginePawnTables.get());
+    if (result.bestMove == Move()) {
+        isPlaying = false;
+        return false;
+    }
+
+    // the time of the search is taken from the clock of the computer, then the increment is added
+    int64_t & clock = engineLimits.clockTime[colorIndex(getSideToMove())];
+    if (clock > 0) {
+        clock = max<int64_t>(1, clock - result.time + engineLimits.increment[colorIndex(getSideToMove())]);
+    }
+
+    char text[6];
+    result.bestMove.write(text);
+
+    *outputStream << white;
+    *outputStream << "   profondeur " << result.depth << ", ";
+    if (isMateScore(result.score)) {
+        *outputStream << "mat en " << (MATE_SCORE - abs(result.score) + 1) / 2 << ", ";
     } else {
-        for (int i = 4; i > 0; i--) {
-            lastMovesBlack[i] = lastMovesBlack[i - 1];
-        }
-        lastMovesBlack[0] = input;
+        *outputStream << "score " << showpos << fixed << setprecision(2) << result.score / 100.0 << noshowpos << ", ";
     }
+    *outputStream << result.nodes << " noeuds en " << result.time << " ms";
+    *outputStream << " (" << result.nodes / max<int64_t>(1, result.time) << " knps)" << endl;
+    *outputStream << "   variation:";
+    for (Move move : result.pv) {
+        char pvText[6];
+        move.write(pvText);
+        *outputStream << " " << pvText;
+    }
+    *outputStream << reset << endl;
 
+    // the computer chooses its promotion piece, nothing is asked
+    makeMove(result.bestMove);
+    concludeMove(text, isWhiteMoving);
     return true;
 }
 
 void Board::game() {
     // ----- Game loop -----
     while (isPlaying) {
-        showBoard();
+        if (rendering) {
+            showBoard();
+        }
+
+        if (enginePlayers[colorIndex(getSideToMove())]) {
+            playEngineMove();
+            continue;
+        }
+
         string input = getInput(isWhitePlaying);
 
         if (input == "/quit") {
@@ -1338,9 +1047,7 @@ void Board::game() {
         }  else if (input == "/draw") {
             drawGame();
         } else {
-            if (!processMove(input))
-                continue;
-            changePlayer();
+            processMove(input);
         }
     }
 
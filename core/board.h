@@ -3,13 +3,27 @@
  * @brief Header file for the game board and its logic
  */
 
+#ifndef BOARD_H
+#define BOARD_H
+
 #include <iostream>
 #include <vector>
 #include <string>
+#include <memory>
+#include <sstream>
+#include <cctype>
 #include <regex>
 
 #include "interface.h"
 #include "pieces.h"
+#include "position.h"
+#include "attacks.h"
+#include "movegen.h"
+#include "zobrist.h"
+#include "weights.h"
+#include "nnue.h"
+#include "pawns.h"
+#include "search.h"
 
 using namespace std;
 
@@ -38,6 +52,24 @@ bool correctKingsideCastlingPattern(string const & cmd);
  * */
 bool correctQueensideCastlingPattern(string const & cmd);
 
+/**
+ * @brief FEN record of the starting position
+*/
+const string STARTING_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+/**
+ * @struct UndoRecord
+ * @brief State saved by makeMove to take the move back
+*/
+struct UndoRecord {
+    Move move;
+    Piece moved;
+    Piece captured;
+    int castlingRights;
+    int enPassantSquare;
+    int nbMovesWithoutTaking;
+};
+
 /**
  * @class Board
  * @brief Class representing the chess board and its logic
@@ -48,7 +80,8 @@ private:
     //           BOARD STATE & GAME VARIABLES
     // ------------------------------------------------
 
-    vector< vector<Piece*> > board;
+    Piece board[8][8];
+    Position position;
     bool isWhitePlaying = true;
     bool isPlaying = true;
     bool check = false;
@@ -58,101 +91,236 @@ private:
 
     string invelidMoveReason = "";
 
-    bool possibleEnPassant = false;
-    string enPassantSquare = "";
+    int enPassantSquare = -1;
+    int castlingRights = 0;
+    int kingSquares[2] = {-1, -1};
+    vector<UndoRecord> undoStack;
+
+    HashKey hashKey = 0;
+    HashKey pawnKey = 0;
+    vector<HashKey> keyHistory;
+
+    int stageScores[2] = {0, 0};
+    int gamePhase = 0;
+    mutable Accumulator accumulator;
 
     int nbMovesWithoutTaking = 0;
-    string lastMovesWhite[5] = {"", "", "", "", ""};
-    string lastMovesBlack[5] = {"", "", "", "", ""};
+
+    istream* inputStream = &cin;       ///< commands of the players
+    ostream* outputStream = &cout;     ///< messages to the players
+    bool rendering = true;             ///< false to never draw the board
+
+    bool enginePlayers[2] = {false, false};
+    SearchLimits engineLimits;
+    shared_ptr<TranspositionTable> engineTable;
+    shared_ptr<vector<PawnTable>> enginePawnTables;   ///< pawn table of each search thread, kept between the moves
+
+    /**
+     * @brief Get the key of the en passant square, only counted if a pawn can take it
+     * @return The key of the column of the en passant square, 0 if there is none
+    */
+    HashKey enPassantHash() const;
+
+    /**
+     * @brief Add or remove the input of a piece in the accumulators of the network, or mark the accumulator of its
+     * perspective as out of date if it is a king
+     * @param piece The piece
+     * @param square The index of the square of the piece
+     * @param added true if the piece is put on the square, false if it is removed
+    */
+    void updateNetworkInput(Piece piece, int square, bool added);
 public:
-    Board() :
-        board(8, vector<Piece*>(8))
-    {}
+    Board() {
+        initAttacks();
+        initZobrist();
+        initEvalWeights();
+    }
 
     // ------------------------------------------------
     //                 MOVE PIECES
     // ------------------------------------------------
 
     /**
-     * @brief Check if the move is valid for a pawn
-     * @param pawn The pawn to move
-     * @param endPiece The piece at the destination square, eventually nullptr
-     * @param start The start square
-     * @param end The end square
+     * @brief Put a piece on a square, keeping the bitboards in sync with the board
+     * @param line The line of the square
+     * @param column The column of the square
+     * @param piece The piece to put on the square, eventually an empty Piece to empty it
     */
-    bool checkPawnMove(Piece* pawn, Piece* endPiece, Square start, Square end);
+    void placePiece(int line, int column, Piece piece);
 
     /**
-     * @brief Check if the move is valid for a rook
-     * @param rook The rook to move
-     * @param endPiece The piece at the destination square, eventually nullptr
-     * @param start The start square
-     * @param end The end square
+     * @brief Put a piece on a square, keeping the bitboards in sync with the board
+     * @param square The index of the square
+     * @param piece The piece to put on the square, eventually an empty Piece to empty it
     */
-    bool checkRookMove(Piece* rook, Piece* endPiece, Square start, Square end);
+    void placePiece(int square, Piece piece);
 
     /**
-     * @brief Check if the move is valid for a knight
-     * @param knight The knight to move
-     * @param endPiece The piece at the destination square, eventually nullptr
-     * @param start The start square
-     * @param end The end square
+     * @brief Play a legal move and give the turn to the other player
+     * @param move The move to play
     */
-    bool checkKnightMove(Piece* knight, Piece* endPiece, Square start, Square end);
+    void makeMove(Move move);
 
     /**
-     * @brief Check if the move is valid for a bishop
-     * @param bishop The bishop to move
-     * @param endPiece The piece at the destination square, eventually nullptr
-     * @param start The start square
-     * @param end The end square
+     * @brief Take back the last move played with makeMove
     */
-    bool checkBishopMove(Piece* bishop, Piece* endPiece, Square start, Square end);
+    void unmakeMove();
+
+    // ------------------------------------------------
+    //                    HASHING
+    // ------------------------------------------------
 
     /**
-     * @brief Check if the move is valid for a queen
-     * @param queen The queen to move
-     * @param endPiece The piece at the destination square, eventually nullptr
-     * @param start The start square
-     * @param end The end square
+     * @brief Compute the Zobrist key of the position from scratch
+     * @return The key of the pieces, the player to move, the castling rights and the en passant column
     */
-    bool checkQueenMove(Piece* queen, Piece* endPiece, Square start, Square end);
+    HashKey computeHashKey() const;
 
     /**
-     * @brief Check if the move is valid for a king
-     * @param king The king to move
-     * @param endPiece The piece at the destination square, eventually nullptr
-     * @param start The start square
-     * @param end The end square
+     * @brief Get the Zobrist key of the position, updated by every move
+     * @return The key of the position
     */
-    bool checkKingMove(Piece* king, Piece* endPiece, Square start, Square end);
+    HashKey getHashKey() const;
 
     /**
-     * @brief Check if the move is valid for a piece, redirect to the correct function
-     * @param piece The piece to move
-     * @param start The start square
-     * @param end The end square
-     * @return true if the move is valid, false otherwise
+     * @brief Get the Zobrist key of the pawns only, updated when a pawn moves, is taken or promotes
+     * @return The key of the pawn structure
+    */
+    HashKey getPawnKey() const;
+
+    /**
+     * @brief Check if the position already occurred since the last capture or pawn move
+     * @param times The number of occurrences to find, the current one included
+     * @return true if the position occurred at least this number of times, false otherwise
+    */
+    bool isRepetition(int times) const;
+
+    /**
+     * @brief Check if the position already occurred twice since the last capture or pawn move
+     * @return true if the position is repeated for the third time, false otherwise
+    */
+    bool isThreefoldRepetition() const;
+
+    // ------------------------------------------------
+    //                  EVALUATION
+    // ------------------------------------------------
+
+    /**
+     * @brief Get the material and piece-square score of the position for a stage of the game, updated by every move
+     * @param stage The stage of the game
+     * @return The score in centipawns, positive if White is better
+    */
+    int getStageScore(Stage stage) const;
+
+    /**
+     * @brief Get the game phase, the sum of the phase weights of the pieces on the board, updated by every move
+     * @return The game phase, MAX_PHASE or more in the opening and 0 with only pawns and kings
+    */
+    int getGamePhase() const;
+
+    /**
+     * @brief Analyze the doubled, isolated, backward and passed pawns of the position, without any table
+     * @return The analysis of the pawn structure
+    */
+    PawnEntry analyzePawns() const;
+
+    /**
+     * @brief Evaluate the position with the neural network, the accumulators of the players whose king moved being
+     * computed again from the pieces (the network must be loaded and both kings on the board)
+     * @return The score in centipawns, positive if the player to move is better
+    */
+    int evaluateWithNetwork() const;
+
+    // ------------------------------------------------
+    //                 POSITION SETUP
+    // ------------------------------------------------
+
+    /**
+     * @brief Set up the board from a FEN record (pieces, player to move, castling rights, en passant square, halfmove clock)
+     * @param fen The FEN record, the move counters are optional
+     * @return true if the record is valid, false otherwise
+    */
+    bool loadFen(const string & fen);
+
+    // ------------------------------------------------
+    //                 MOVE GENERATION
+    // ------------------------------------------------
+
+    /**
+     * @brief Get the bitboards of the pieces
+     * @return The position, kept in sync with the board
+    */
+    const Position & getPosition() const;
+
+    /**
+     * @brief Get the piece standing on a square
+     * @param square The index of the square
+     * @return The piece, empty if there is none
+    */
+    Piece getPiece(int square) const;
+
+    /**
+     * @brief Get the last move played with makeMove
+     * @return The last move, empty if no move was played since the position was set up
+    */
+    Move getLastMove() const;
+
+    /**
+     * @brief Get the color of the player to move
+     * @return The color of the player to move
     */
-    bool checkPieceMove(Piece* piece, Square start, Square end);
+    Color getSideToMove() const;
+
+    /**
+     * @brief Get the number of moves played since the last capture or pawn move
+     * @return The halfmove clock
+    */
+    int getHalfmoveClock() const;
+
+    /**
+     * @brief Get the castling rights, lost when the king or the rook moves or the rook is taken
+     * @return The castling rights (combination of CastlingRight flags)
+    */
+    int getCastlingRights() const;
+
+    /**
+     * @brief Fill the list with the legal moves of a player
+     * @param moves The list to fill
+     * @param isWhitePlaying true to generate the white moves, false for the black ones
+    */
+    void generateLegalMoves(MoveList & moves, bool isWhitePlaying) const;
+
+    /**
+     * @brief Fill the list with the legal moves of the player to move
+     * @param moves The list to fill
+    */
+    void generateLegalMoves(MoveList & moves) const;
 
     // ------------------------------------------------
     //           CHECK, CHECKMATE & STALEMATE
     // ------------------------------------------------
 
     /**
-     * @brief find the position of the king
+     * @brief find the position of the king, kept up to date when the king is placed
      * @param isWhitePlaying true if it is the white player's turn, false otherwise
-     * @return the position of the king
+     * @return the index of the square of the king, -1 if there is no king
     */
-    string findKingPosition(bool isWhitePlaying);
+    int findKingPosition(bool isWhitePlaying) const;
+
+    /**
+     * @brief Check if a square is attacked, looking from the square along the knight, king, pawn and slider rays
+     * @param square The index of the square
+     * @param byColor The color of the attacking pieces
+     * @return true if a piece of this color attacks the square, false otherwise
+    */
+    bool isSquareAttacked(int square, Color byColor) const;
 
     /**
      * @brief Check if the king is in check
      * @param isWhitePlaying true if it is the white player's turn, false otherwise
      * @return true if the king is in check, false otherwise
     */
-    bool isCheck(bool isWhitePlaying);
+    bool isCheck(bool isWhitePlaying) const;
 
     /**
      * @brief Check if the king is in checkmate
@@ -185,7 +353,7 @@ public:
     /**
      * @brief Get the input from the player (move, quit, help, resign, draw)
      * @param isWhitePlaying true if it is the white player's turn, false otherwise
-     * @return the input from the player
+     * @return the input from the player, "/quit" at the end of the commands
     */
     string getInput(bool isWhitePlaying);
 
@@ -197,6 +365,15 @@ public:
     */
     bool validMove(string input, bool isWhitePlaying);
 
+    /**
+     * @brief Check if the move is valid and find the matching legal move
+     * @param input The input move
+     * @param isWhitePlaying true if it is the white player's turn, false otherwise
+     * @param move The legal move, set if the move is valid
+     * @return true if the move is valid, false otherwise
+    */
+    bool validMove(string input, bool isWhitePlaying, Move & move);
+
     /**
      * @brief Check if the kingside castling move is valid
      * @param isWhitePlaying true if it is the white player's turn, false otherwise
@@ -253,9 +430,46 @@ public:
     bool processQueensideCastlingMove();
 
     /**
-     * @brief handle the move input
+     * @brief Print the move just played and look for the end of the game (checkmate, stalemate)
+     * @param input The move as typed or played by the computer
+     * @param isWhiteMoving true if the white player played the move, false otherwise
+     * @return false if the move ends the game with a checkmate, true otherwise
+    */
+    bool concludeMove(string input, bool isWhiteMoving);
+
+    /**
+     * @brief Choose where the commands are read and the messages written, the console by default
+     * @param input The stream of the commands of the players
+     * @param output The stream of the messages, a stream without buffer (ostream(nullptr)) to write nothing
+     * @param render true to draw the board before each move, false to never draw it
+    */
+    void setStreams(istream & input, ostream & output, bool render);
+
+    /**
+     * @brief Check if the game is over (checkmate, stalemate, resignation or draw)
+     * @return true if the game is over, false if it goes on
+    */
+    bool isGameOver() const;
+
+    /**
+     * @brief Choose the players played by the computer
+     * @param whiteEngine true if the computer plays the white pieces, false for a human player
+     * @param blackEngine true if the computer plays the black pieces, false for a human player
+     * @param limits The limits of the search of each move of the computer
+     * @param hashMegabytes The size of the transposition table kept between the moves of the computer
+    */
+    void setEnginePlayers(bool whiteEngine, bool blackEngine, const SearchLimits & limits, size_t hashMegabytes);
+
+    /**
+     * @brief Search and play the move of the computer for the player to move
+     * @return true if a move is played, false if the computer has no legal move
+    */
+    bool playEngineMove();
+
+    /**
+     * @brief handle the move input, the turn goes to the other player if the move is played
      * @param input The input move
-     * @return true if the move is valid, false otherwise
+     * @return true if the move is valid and the game goes on, false otherwise
     */
     bool processMove(string input);
 
@@ -270,3 +484,5 @@ public:
     */
     string canonical_position() const;
 };
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * @file evaluate.cpp
+ * @brief Implementation file for the static evaluation of the positions
+ */
+
+#include "evaluate.h"
+
+int evaluate(const Board & board, PawnTable * pawns) {
+    const Position & position = board.getPosition();
+    Bitboard whiteKing = position.getPieces(Color::WHITE, PieceType::KING);
+    Bitboard blackKing = position.getPieces(Color::BLACK, PieceType::KING);
+    if (networkLoaded && whiteKing && blackKing) {
+        return board.evaluateWithNetwork();
+    }
+
+    // the scores are kept up to date by the moves, the pawn structure only changes with the pawns
+    PawnEntry analyzed;
+    PawnEntry & structure = pawns ? pawns->probe(board.getPawnKey(), position) : (analyzed = board.analyzePawns());
+    int middlegame = board.getStageScore(MIDDLEGAME) + structure.scores[MIDDLEGAME];
+    int endgame = board.getStageScore(ENDGAME) + structure.scores[ENDGAME];
+    if (whiteKing && blackKing) {
+        middlegame += kingShield(structure, position, Color::WHITE, lsb(whiteKing));
+        middlegame -= kingShield(structure, position, Color::BLACK, lsb(blackKing));
+    }
+
+    int phase = min(board.getGamePhase(), MAX_PHASE);
+    int score = (middlegame * phase + endgame * (MAX_PHASE - phase)) / MAX_PHASE;
+
+    return board.getSideToMove() == Color::WHITE ? score : -score;
+}
+
+// ------------------------------------------------
+//             STATIC EXCHANGE EVALUATION
+// ------------------------------------------------
+
+int staticExchange(const Board & board, Move move) {
+    const Position & position = board.getPosition();
+    int from = move.getFrom();
+    int to = move.getTo();
+    Color side = board.getSideToMove();
+
+    // gains[i] is the material won by the player making the ith capture if the exchange stopped there
+    int gains[32];
+    int depth = 0;
+    Bitboard occupancy = position.getOccupancy() ^ squareBit(from);
+
+    if (move.getKind() == MoveKind::EN_PASSANT) {
+        gains[0] = PIECE_VALUES[typeIndex(PieceType::PAWN)];
+        occupancy ^= squareBit(squareIndex(squareLine(from), squareColumn(to)));
+    } else {
+        Piece victim = board.getPiece(to);
+        gains[0] = victim.isEmpty() ? 0 : PIECE_VALUES[typeIndex(victim.getType())];
+    }
+
+    // the piece standing on the square, which the next capture takes
+    int onSquare = PIECE_VALUES[typeIndex(board.getPiece(from).getType())];
+    if (move.getKind() == MoveKind::PROMOTION) {
+        onSquare = PIECE_VALUES[typeIndex(move.getPromotion())];
+        gains[0] += onSquare - PIECE_VALUES[typeIndex(PieceType::PAWN)];
+    }
+
+    Bitboard diagonals =
+        position.getPieces(Color::WHITE, PieceType::BISHOP) | position.getPieces(Color::WHITE, PieceType::QUEEN) |
+        position.getPieces(Color::BLACK, PieceType::BISHOP) | position.getPieces(Color::BLACK, PieceType::QUEEN);
+    Bitboard lines =
+        position.getPieces(Color::WHITE, PieceType::ROOK) | position.getPieces(Color::WHITE, PieceType::QUEEN) |
+        position.getPieces(Color::BLACK, PieceType::ROOK) | position.getPieces(Color::BLACK, PieceType::QUEEN);
+    Bitboard attackers = position.attackersTo(to, occupancy) & occupancy;
+
+    side = opponent(side);
+    while (depth < 31) {
+        Bitboard ours = attackers & position.getColorOccupancy(side);
+        if (!ours) {
+            break;
+        }
+
+        // the least valuable attacker captures
+        int type = 0;
+        while (!(ours & position.getPieces(side, static_cast<PieceType>(type)))) {
+            type++;
+        }
+        Bitboard attacker = ours & position.getPieces(side, static_cast<PieceType>(type));
+        attacker &= ~attacker + 1;
+
+        // the sliders behind it join the exchange
+        occupancy ^= attacker;
+        attackers |= (bishopAttacks(to, occupancy) & diagonals) | (rookAttacks(to, occupancy) & lines);
+        attackers &= occupancy;
+
+        // the king can't capture a defended piece
+        if (static_cast<PieceType>(type) == PieceType::KING && (attackers & position.getColorOccupancy(opponent(side)))) {
+            break;
+        }
+
+        depth++;
+        gains[depth] = onSquare - gains[depth - 1];
+        onSquare = PIECE_VALUES[type];
+        side = opponent(side);
+    }
+
+    // each player stops capturing if going on loses material
+    while (depth > 0) {
+        gains[depth - 1] = -max(-gains[depth - 1], gains[depth]);
+        depth--;
+    }
+
+    return gains[0];
+}
@@ -0,0 +1,36 @@
+/**
+ * @file evaluate.h
+ * @brief Header file for the static evaluation of the positions
+ */
+
+#ifndef EVALUATE_H
+#define EVALUATE_H
+
+#include "board.h"
+
+using namespace std;
+
+/**
+ * @brief Value of each piece type in centipawns, indexed by typeIndex, used to order and prune the captures
+*/
+const int PIECE_VALUES[6] = {100, 320, 330, 500, 900, 0};
+
+/**
+ * @brief Evaluate the position without searching, with the neural network if one is loaded, otherwise from the material,
+ * the piece-square tables and the pawn structure blended by game phase
+ * @param board The board
+ * @param pawns The pawn structures already analyzed by the thread, nullptr to analyze the structure every time
+ * @return The score in centipawns, positive if the player to move is better
+*/
+int evaluate(const Board & board, PawnTable * pawns = nullptr);
+
+/**
+ * @brief Compute the material won by a move once every exchange on its end square is played, the pieces always
+ * capturing with the least valuable attacker first and each player being free to stop capturing (pins are ignored)
+ * @param board The board, before the move
+ * @param move The move
+ * @return The material won in centipawns by the player to move, negative if the move loses material
+*/
+int staticExchange(const Board & board, Move move);
+
+#endif
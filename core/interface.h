@@ -3,6 +3,9 @@
  * @brief Header file for the game interface & colors
  */
 
+#ifndef INTERFACE_H
+#define INTERFACE_H
+
 #include <iostream>
 
 using namespace std;
@@ -36,4 +39,6 @@ void printHelp();
 /**
  * @brief Print the quit message
 */
-void printQuit();
\ No newline at end of file
+void printQuit();
+
+#endif
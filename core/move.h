@@ -0,0 +1,178 @@
+/**
+ * @file move.h
+ * @brief Header file for the compact move encoding and the move list
+ */
+
+#ifndef MOVE_H
+#define MOVE_H
+
+#include <cstdint>
+
+#include "pieces.h"
+
+using namespace std;
+
+/**
+ * @enum MoveKind
+ * @brief Enumerates the special kinds of moves
+*/
+enum class MoveKind {
+    NORMAL,
+    PROMOTION,
+    EN_PASSANT,
+    CASTLING
+};
+
+/**
+ * @class Move
+ * @brief Class representing a move packed in 16 bits (start, end, kind, promotion piece)
+*/
+class Move {
+private:
+    uint16_t data;
+public:
+    Move() :
+        data(0)
+    {}
+
+    Move(int from, int to, MoveKind kind = MoveKind::NORMAL, PieceType promotion = PieceType::KNIGHT) :
+        data(uint16_t(
+            from |
+            to << 6 |
+            static_cast<int>(kind) << 12 |
+            (static_cast<int>(promotion) - static_cast<int>(PieceType::KNIGHT)) << 14
+        ))
+    {}
+
+    /**
+     * @brief Build a move from its packed value
+     * @param data The packed value, as given by getData
+     * @return The move
+    */
+    static Move fromData(uint16_t data) {
+        Move move;
+        move.data = data;
+        return move;
+    }
+
+    /**
+     * @brief Get the packed value of the move, used to save it in tables
+     * @return The packed value, 0 for an empty move
+    */
+    uint16_t getData() const {
+        return data;
+    }
+
+    /**
+     * @brief Get the start square of the move
+     * @return The index of the start square
+    */
+    int getFrom() const {
+        return data & 63;
+    }
+
+    /**
+     * @brief Get the end square of the move, for castling the end square of the king
+     * @return The index of the end square
+    */
+    int getTo() const {
+        return (data >> 6) & 63;
+    }
+
+    /**
+     * @brief Get the kind of the move
+     * @return The kind of the move
+    */
+    MoveKind getKind() const {
+        return static_cast<MoveKind>((data >> 12) & 3);
+    }
+
+    /**
+     * @brief Get the piece chosen for a promotion
+     * @return The type of the new piece (knight, bishop, rook or queen)
+    */
+    PieceType getPromotion() const {
+        return static_cast<PieceType>((data >> 14) + static_cast<int>(PieceType::KNIGHT));
+    }
+
+    /**
+     * @brief Write the move in coordinate notation ("e2e4", "e7e8q") in a buffer, followed by a null character
+     * @param buffer The buffer to fill, at least 6 characters long
+     * @return A pointer to the null character, to append more text
+    */
+    char* write(char* buffer) const {
+        char* end = Square(getTo()).write(Square(getFrom()).write(buffer));
+        if (getKind() == MoveKind::PROMOTION) {
+            *end++ = "nbrq"[(data >> 14)];
+            *end = '\0';
+        }
+        return end;
+    }
+
+    bool operator==(const Move & other) const {
+        return data == other.data;
+    }
+
+    bool operator!=(const Move & other) const {
+        return data != other.data;
+    }
+};
+
+/**
+ * @class MoveList
+ * @brief Fixed capacity list of moves, meant to be allocated on the stack
+*/
+class MoveList {
+private:
+    Move moves[256];
+    int count = 0;
+public:
+    /**
+     * @brief Add a move at the end of the list
+     * @param move The move to add
+    */
+    void add(Move move) {
+        moves[count++] = move;
+    }
+
+    /**
+     * @brief Empty the list
+    */
+    void clear() {
+        count = 0;
+    }
+
+    /**
+     * @brief Get the number of moves in the list
+     * @return The number of moves
+    */
+    int size() const {
+        return count;
+    }
+
+    /**
+     * @brief Check if the list has no move
+     * @return true if the list is empty, false otherwise
+    */
+    bool empty() const {
+        return count == 0;
+    }
+
+    Move & operator[](int index) {
+        return moves[index];
+    }
+
+    const Move & operator[](int index) const {
+        return moves[index];
+    }
+
+    const Move* begin() const {
+        return moves;
+    }
+
+    const Move* end() const {
+        return moves + count;
+    }
+};
+
+#endif
@@ -0,0 +1,314 @@
+/**
+ * @file movegen.cpp
+ * @brief Implementation file for the move generation from the bitboards
+ */
+
+#include "movegen.h"
+
+#include <cassert>
+
+/**
+ * @struct Restrictions
+ * @brief Squares the pieces of the player may reach without leaving their king in check
+*/
+struct Restrictions {
+    Bitboard checkMask;     ///< squares blocking or capturing the checking piece, all squares if not in check
+    Bitboard pinned;        ///< pieces pinned against their king
+    Bitboard pinRays[64];   ///< for each pinned piece, the squares between the king and the pinning piece (included)
+    bool legal;             ///< false to generate pseudo legal moves, the masks are then ignored
+};
+
+// ------------------------------------------------
+//                 MOVE HELPERS
+// ------------------------------------------------
+
+/**
+ * @brief Add a move for every target square of a piece
+ * @param from The square of the piece
+ * @param targets The squares the piece can go to
+ * @param moves The list to fill
+*/
+static void addTargets(int from, Bitboard targets, MoveList & moves) {
+    while (targets) {
+        moves.add(Move(from, popLsb(targets)));
+    }
+}
+
+/**
+ * @brief Add a pawn move, split in the 4 promotion choices if the pawn reaches the last line
+ * @param from The square of the pawn
+ * @param to The end square of the pawn
+ * @param moves The list to fill
+*/
+static void addPawnMove(int from, int to, MoveList & moves) {
+    if (squareLine(to) == 0 || squareLine(to) == 7) {
+        moves.add(Move(from, to, MoveKind::PROMOTION, PieceType::QUEEN));
+        moves.add(Move(from, to, MoveKind::PROMOTION, PieceType::ROOK));
+        moves.add(Move(from, to, MoveKind::PROMOTION, PieceType::BISHOP));
+        moves.add(Move(from, to, MoveKind::PROMOTION, PieceType::KNIGHT));
+        return;
+    }
+
+    moves.add(Move(from, to));
+}
+
+/**
+ * @brief Get the squares a piece may reach according to the check and pin masks
+ * @param from The square of the piece
+ * @param restrictions The masks of the position
+ * @return The allowed squares
+*/
+static Bitboard allowedSquares(int from, const Restrictions & restrictions) {
+    if (!restrictions.legal) {
+        return ~Bitboard(0);
+    }
+
+    if (restrictions.pinned & squareBit(from)) {
+        return restrictions.checkMask & restrictions.pinRays[from];
+    }
+
+    return restrictions.checkMask;
+}
+
+// ------------------------------------------------
+//                 PIECE MOVES
+// ------------------------------------------------
+
+/**
+ * @brief Generate the moves of the pawns of a player
+*/
+static void generatePawnMoves(const Position & position, Color side, int enPassantSquare, const Restrictions & restrictions, MoveList & moves) {
+    int forward = side == Color::WHITE ? 8 : -8;
+    int startLine = side == Color::WHITE ? 1 : 6;
+    Bitboard opponents = position.getColorOccupancy(opponent(side));
+
+    Bitboard pawns = position.getPieces(side, PieceType::PAWN);
+    while (pawns) {
+        int from = popLsb(pawns);
+        Bitboard allowed = allowedSquares(from, restrictions);
+
+        // pawn is moving forward by one or two squares
+        int to = from + forward;
+        if (!position.isOccupied(to)) {
+            if (allowed & squareBit(to)) {
+                addPawnMove(from, to, moves);
+            }
+
+            if (
+                squareLine(from) == startLine &&
+                !position.isOccupied(to + forward) &&
+                (allowed & squareBit(to + forward))
+            ) {
+                moves.add(Move(from, to + forward));
+            }
+        }
+
+        // pawn is capturing a piece
+        Bitboard captures = pawnAttacks(side, from) & opponents & allowed;
+        while (captures) {
+            addPawnMove(from, popLsb(captures), moves);
+        }
+
+        // pawn is capturing a piece using en passant move: two pawns leave the line of the king at
+        // once, so the masks can't tell if it is legal and the move is tried on a copy of the position
+        if (enPassantSquare != -1 && (pawnAttacks(side, from) & squareBit(enPassantSquare))) {
+            Move move(from, enPassantSquare, MoveKind::EN_PASSANT);
+            if (!restrictions.legal || isLegalMove(position, side, move)) {
+                moves.add(move);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Generate the moves of the knights, bishops, rooks and queens of a player
+*/
+static void generatePieceMoves(const Position & position, Color side, const Restrictions & restrictions, MoveList & moves) {
+    Bitboard targets = ~position.getColorOccupancy(side);
+    Bitboard occupancy = position.getOccupancy();
+
+    // a pinned knight can never stay on the ray of its pin
+    Bitboard knights = position.getPieces(side, PieceType::KNIGHT);
+    while (knights) {
+        int from = popLsb(knights);
+        addTargets(from, knightAttacks(from) & targets & allowedSquares(from, restrictions), moves);
+    }
+
+    Bitboard bishops = position.getPieces(side, PieceType::BISHOP);
+    while (bishops) {
+        int from = popLsb(bishops);
+        addTargets(from, bishopAttacks(from, occupancy) & targets & allowedSquares(from, restrictions), moves);
+    }
+
+    Bitboard rooks = position.getPieces(side, PieceType::ROOK);
+    while (rooks) {
+        int from = popLsb(rooks);
+        addTargets(from, rookAttacks(from, occupancy) & targets & allowedSquares(from, restrictions), moves);
+    }
+
+    Bitboard queens = position.getPieces(side, PieceType::QUEEN);
+    while (queens) {
+        int from = popLsb(queens);
+        addTargets(from, queenAttacks(from, occupancy) & targets & allowedSquares(from, restrictions), moves);
+    }
+}
+
+/**
+ * @brief Generate the castling moves of a player whose king is not in check and doesn't cross or reach an attacked square
+*/
+static void generateCastlingMoves(const Position & position, Color side, int castlingRights, MoveList & moves) {
+    int base = side == Color::WHITE ? 0 : 56;
+    int kingside = side == Color::WHITE ? WHITE_KINGSIDE : BLACK_KINGSIDE;
+    int queenside = side == Color::WHITE ? WHITE_QUEENSIDE : BLACK_QUEENSIDE;
+    Color them = opponent(side);
+    Bitboard rooks = position.getPieces(side, PieceType::ROOK);
+
+    if (!(castlingRights & (kingside | queenside))) {
+        return;
+    }
+
+    // the rights are lost once the king moves, and only kept by loadFen with the king on its square
+    assert(position.getPieces(side, PieceType::KING) & squareBit(base + 4));
+    if (position.isSquareAttacked(base + 4, them)) {
+        return;
+    }
+
+    if (
+        (castlingRights & kingside) &&
+        (rooks & squareBit(base + 7)) &&
+        !position.isOccupied(base + 5) &&
+        !position.isOccupied(base + 6) &&
+        !position.isSquareAttacked(base + 5, them) &&
+        !position.isSquareAttacked(base + 6, them)
+    ) {
+        moves.add(Move(base + 4, base + 6, MoveKind::CASTLING));
+    }
+
+    if (
+        (castlingRights & queenside) &&
+        (rooks & squareBit(base)) &&
+        !position.isOccupied(base + 1) &&
+        !position.isOccupied(base + 2) &&
+        !position.isOccupied(base + 3) &&
+        !position.isSquareAttacked(base + 3, them) &&
+        !position.isSquareAttacked(base + 2, them)
+    ) {
+        moves.add(Move(base + 4, base + 2, MoveKind::CASTLING));
+    }
+}
+
+// ------------------------------------------------
+//              PSEUDO LEGAL MOVES
+// ------------------------------------------------
+
+void generatePseudoLegalMoves(const Position & position, Color side, int castlingRights, int enPassantSquare, MoveList & moves) {
+    Restrictions restrictions;
+    restrictions.legal = false;
+
+    generatePawnMoves(position, side, enPassantSquare, restrictions, moves);
+    generatePieceMoves(position, side, restrictions, moves);
+
+    Bitboard king = position.getPieces(side, PieceType::KING);
+    if (king) {
+        int from = lsb(king);
+        addTargets(from, kingAttacks(from) & ~position.getColorOccupancy(side), moves);
+        generateCastlingMoves(position, side, castlingRights, moves);
+    }
+}
+
+// ------------------------------------------------
+//                  LEGAL MOVES
+// ------------------------------------------------
+
+bool isLegalMove(const Position & position, Color side, Move move) {
+    Position after = position;
+    Color them = opponent(side);
+    int from = move.getFrom();
+    int to = move.getTo();
+
+    PieceType type = PieceType::PAWN;
+    after.findPiece(side, from, type);
+
+    // remove the captured piece
+    PieceType captured;
+    if (move.getKind() == MoveKind::EN_PASSANT) {
+        after.removePiece(them, PieceType::PAWN, to + (side == Color::WHITE ? -8 : 8));
+    } else if (after.findPiece(them, to, captured)) {
+        after.removePiece(them, captured, to);
+    }
+
+    // move the piece, and the rook for a castling
+    if (move.getKind() == MoveKind::PROMOTION) {
+        after.removePiece(side, PieceType::PAWN, from);
+        after.addPiece(side, move.getPromotion(), to);
+    } else {
+        after.movePiece(side, type, from, to);
+    }
+
+    if (move.getKind() == MoveKind::CASTLING) {
+        int base = from - 4;
+        if (to > from) {
+            after.movePiece(side, PieceType::ROOK, base + 7, base + 5);
+        } else {
+            after.movePiece(side, PieceType::ROOK, base, base + 3);
+        }
+    }
+
+    Bitboard king = after.getPieces(side, PieceType::KING);
+    return king == 0 || !after.isSquareAttacked(lsb(king), them);
+}
+
+void generateLegalMoves(const Position & position, Color side, int castlingRights, int enPassantSquare, MoveList & moves) {
+    Bitboard kingBitboard = position.getPieces(side, PieceType::KING);
+    if (kingBitboard == 0) {
+        generatePseudoLegalMoves(position, side, castlingRights, enPassantSquare, moves);
+        return;
+    }
+
+    Color them = opponent(side);
+    int king = lsb(kingBitboard);
+    Bitboard ours = position.getColorOccupancy(side);
+    Bitboard theirs = position.getColorOccupancy(them);
+    Bitboard occupancy = position.getOccupancy();
+
+    // the king can go to any square not attacked once it has left its square
+    Bitboard kingTargets = kingAttacks(king) & ~ours;
+    while (kingTargets) {
+        int to = popLsb(kingTargets);
+        if (!(position.attackersTo(to, occupancy ^ squareBit(king)) & theirs)) {
+            moves.add(Move(king, to));
+        }
+    }
+
+    // with two checking pieces only the king can move
+    Bitboard checkers = position.attackersTo(king, occupancy) & theirs;
+    if (popCount(checkers) > 1) {
+        return;
+    }
+
+    Restrictions restrictions;
+    restrictions.legal = true;
+    restrictions.checkMask = checkers ? betweenSquares(king, lsb(checkers)) | checkers : ~Bitboard(0);
+    restrictions.pinned = 0;
+
+    // a piece is pinned if it is the only one between the king and an opponent slider
+    Bitboard snipers =
+        (rookAttacks(king, 0) & (position.getPieces(them, PieceType::ROOK) | position.getPieces(them, PieceType::QUEEN))) |
+        (bishopAttacks(king, 0) & (position.getPieces(them, PieceType::BISHOP) | position.getPieces(them, PieceType::QUEEN)));
+    while (snipers) {
+        int sniper = popLsb(snipers);
+        Bitboard blockers = betweenSquares(king, sniper) & occupancy;
+        if (popCount(blockers) == 1 && (blockers & ours)) {
+            int pinnedSquare = lsb(blockers);
+            restrictions.pinned |= blockers;
+            restrictions.pinRays[pinnedSquare] = betweenSquares(king, sniper) | squareBit(sniper);
+        }
+    }
+
+    generatePawnMoves(position, side, enPassantSquare, restrictions, moves);
+    generatePieceMoves(position, side, restrictions, moves);
+
+    if (!checkers) {
+        generateCastlingMoves(position, side, castlingRights, moves);
+    }
+}
@@ -0,0 +1,43 @@
+/**
+ * @file movegen.h
+ * @brief Header file for the move generation from the bitboards
+ */
+
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+#include "move.h"
+#include "position.h"
+
+using namespace std;
+
+/**
+ * @brief Generate the moves following the piece patterns, without checking if they leave the king in check
+ * @param position The position
+ * @param side The color of the player to move
+ * @param castlingRights The castling rights (combination of CastlingRight flags)
+ * @param enPassantSquare The square a pawn can capture en passant, -1 if none
+ * @param moves The list to fill
+*/
+void generatePseudoLegalMoves(const Position & position, Color side, int castlingRights, int enPassantSquare, MoveList & moves);
+
+/**
+ * @brief Check if a pseudo legal move doesn't leave the king of the player in check, by playing it on a copy
+ * @param position The position
+ * @param side The color of the player to move
+ * @param move The move to check
+ * @return true if the move is legal, false otherwise
+*/
+bool isLegalMove(const Position & position, Color side, Move move);
+
+/**
+ * @brief Generate the legal moves of a player, filtered once per position with the check and pin masks
+ * @param position The position
+ * @param side The color of the player to move
+ * @param castlingRights The castling rights (combination of CastlingRight flags)
+ * @param enPassantSquare The square a pawn can capture en passant, -1 if none
+ * @param moves The list to fill
+*/
+void generateLegalMoves(const Position & position, Color side, int castlingRights, int enPassantSquare, MoveList & moves);
+
+#endif
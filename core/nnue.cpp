@@ -0,0 +1,301 @@
+/**
+ * @file nnue.cpp
+ * @brief Implementation file for the efficiently updatable neural network evaluating the positions
+ */
+
+#include "nnue.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @struct Network
+ * @brief Weights of the layers, pointing in the mapped file
+*/
+struct Network {
+    const int16_t* inputBiases;
+    const int16_t* inputWeights;
+    const int32_t* hiddenBiases[2];
+    const int8_t* hiddenWeights[2];
+    int32_t outputBias;
+    const int8_t* outputWeights;
+
+    void* mapping = nullptr;
+    size_t size = 0;
+};
+
+static Network network;
+bool networkLoaded = false;
+
+static const char NETWORK_MAGIC[8] = {'E', 'C', 'H', 'N', 'N', 'U', 'E', '1'};
+
+// the hidden layers take the sums divided by 64, the output is divided by 16 to give centipawns
+static const int HIDDEN_SHIFT = 6;
+static const int OUTPUT_SCALE = 16;
+
+// ------------------------------------------------
+//                 SCALAR KERNELS
+// ------------------------------------------------
+
+static void addRowScalar(int16_t* values, const int16_t* row) {
+    for (int i = 0; i < NNUE_HIDDEN; i++) {
+        values[i] += row[i];
+    }
+}
+
+static void subRowScalar(int16_t* values, const int16_t* row) {
+    for (int i = 0; i < NNUE_HIDDEN; i++) {
+        values[i] -= row[i];
+    }
+}
+
+static int32_t dotProductScalar(const uint8_t* inputs, const int8_t* weights, int size) {
+    int32_t sum = 0;
+    for (int i = 0; i < size; i++) {
+        sum += inputs[i] * weights[i];
+    }
+    return sum;
+}
+
+// ------------------------------------------------
+//                  SIMD KERNELS
+// ------------------------------------------------
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse4.1")))
+static void addRowSse(int16_t* values, const int16_t* row) {
+    for (int i = 0; i < NNUE_HIDDEN; i += 8) {
+        __m128i* target = reinterpret_cast<__m128i*>(values + i);
+        _mm_store_si128(target, _mm_add_epi16(_mm_load_si128(target), _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i))));
+    }
+}
+
+__attribute__((target("sse4.1")))
+static void subRowSse(int16_t* values, const int16_t* row) {
+    for (int i = 0; i < NNUE_HIDDEN; i += 8) {
+        __m128i* target = reinterpret_cast<__m128i*>(values + i);
+        _mm_store_si128(target, _mm_sub_epi16(_mm_load_si128(target), _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i))));
+    }
+}
+
+/**
+ * @brief Dot product of 16 inputs at a time: the byte products are summed by pairs in 16 bits (which can't
+ * overflow as the inputs are at most 127), then by pairs again in 32 bits
+*/
+__attribute__((target("sse4.1")))
+static int32_t dotProductSse(const uint8_t* inputs, const int8_t* weights, int size) {
+    __m128i ones = _mm_set1_epi16(1);
+    __m128i sum = _mm_setzero_si128();
+    for (int i = 0; i < size; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inputs + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(a, b), ones));
+    }
+
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+}
+
+__attribute__((target("avx2")))
+static void addRowAvx2(int16_t* values, const int16_t* row) {
+    for (int i = 0; i < NNUE_HIDDEN; i += 16) {
+        __m256i* target = reinterpret_cast<__m256i*>(values + i);
+        _mm256_store_si256(target, _mm256_add_epi16(_mm256_load_si256(target), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i))));
+    }
+}
+
+__attribute__((target("avx2")))
+static void subRowAvx2(int16_t* values, const int16_t* row) {
+    for (int i = 0; i < NNUE_HIDDEN; i += 16) {
+        __m256i* target = reinterpret_cast<__m256i*>(values + i);
+        _mm256_store_si256(target, _mm256_sub_epi16(_mm256_load_si256(target), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i))));
+    }
+}
+
+/**
+ * @brief Same as dotProductSse with 32 inputs at a time
+*/
+__attribute__((target("avx2")))
+static int32_t dotProductAvx2(const uint8_t* inputs, const int8_t* weights, int size) {
+    __m256i ones = _mm256_set1_epi16(1);
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < size; i += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inputs + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(a, b), ones));
+    }
+
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+    return _mm_cvtsi128_si32(half);
+}
+#endif
+
+// kernels used by the network, chosen when it is loaded
+static void (*addRow)(int16_t*, const int16_t*) = addRowScalar;
+static void (*subRow)(int16_t*, const int16_t*) = subRowScalar;
+static int32_t (*dotProduct)(const uint8_t*, const int8_t*, int) = dotProductScalar;
+static const char* instructions = "scalaire";
+
+/**
+ * @brief Choose the fastest kernels the CPU running the program can execute
+*/
+static void chooseKernels() {
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("avx2")) {
+        addRow = addRowAvx2;
+        subRow = subRowAvx2;
+        dotProduct = dotProductAvx2;
+        instructions = "AVX2";
+        return;
+    }
+
+    if (__builtin_cpu_supports("sse4.1")) {
+        addRow = addRowSse;
+        subRow = subRowSse;
+        dotProduct = dotProductSse;
+        instructions = "SSE4.1";
+        return;
+    }
+#endif
+
+    addRow = addRowScalar;
+    subRow = subRowScalar;
+    dotProduct = dotProductScalar;
+    instructions = "scalaire";
+}
+
+// ------------------------------------------------
+//                  LOADING
+// ------------------------------------------------
+
+bool loadNetwork(const string & path) {
+    size_t expectedSize =
+        sizeof(NETWORK_MAGIC) +
+        NNUE_HIDDEN * sizeof(int16_t) + size_t(NNUE_INPUTS) * NNUE_HIDDEN * sizeof(int16_t) +
+        NNUE_DENSE * sizeof(int32_t) + 2 * NNUE_HIDDEN * NNUE_DENSE +
+        NNUE_DENSE * sizeof(int32_t) + NNUE_DENSE * NNUE_DENSE +
+        sizeof(int32_t) + NNUE_DENSE;
+
+    int file = open(path.c_str(), O_RDONLY);
+    if (file == -1) {
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) == -1 || size_t(status.st_size) != expectedSize) {
+        close(file);
+        return false;
+    }
+
+    // the pages are read from the file when the layers first need them, and shared by the threads
+    void* mapping = mmap(nullptr, expectedSize, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const char* data = static_cast<const char*>(mapping);
+    if (memcmp(data, NETWORK_MAGIC, sizeof(NETWORK_MAGIC)) != 0) {
+        munmap(mapping, expectedSize);
+        return false;
+    }
+
+    if (network.mapping) {
+        munmap(network.mapping, network.size);
+    }
+    network.mapping = mapping;
+    network.size = expectedSize;
+
+    data += sizeof(NETWORK_MAGIC);
+    network.inputBiases = reinterpret_cast<const int16_t*>(data);
+    data += NNUE_HIDDEN * sizeof(int16_t);
+    network.inputWeights = reinterpret_cast<const int16_t*>(data);
+    data += size_t(NNUE_INPUTS) * NNUE_HIDDEN * sizeof(int16_t);
+
+    int hiddenInputs[2] = {2 * NNUE_HIDDEN, NNUE_DENSE};
+    for (int layer = 0; layer < 2; layer++) {
+        network.hiddenBiases[layer] = reinterpret_cast<const int32_t*>(data);
+        data += NNUE_DENSE * sizeof(int32_t);
+        network.hiddenWeights[layer] = reinterpret_cast<const int8_t*>(data);
+        data += NNUE_DENSE * hiddenInputs[layer];
+    }
+
+    memcpy(&network.outputBias, data, sizeof(int32_t));
+    data += sizeof(int32_t);
+    network.outputWeights = reinterpret_cast<const int8_t*>(data);
+
+    chooseKernels();
+    networkLoaded = true;
+    return true;
+}
+
+const char* networkInstructions() {
+    return instructions;
+}
+
+// ------------------------------------------------
+//                 FIRST LAYER
+// ------------------------------------------------
+
+void addInput(Accumulator & accumulator, Color perspective, int input) {
+    addRow(accumulator.values[colorIndex(perspective)], network.inputWeights + size_t(input) * NNUE_HIDDEN);
+}
+
+void removeInput(Accumulator & accumulator, Color perspective, int input) {
+    subRow(accumulator.values[colorIndex(perspective)], network.inputWeights + size_t(input) * NNUE_HIDDEN);
+}
+
+void refreshAccumulator(Accumulator & accumulator, Color perspective, const int* inputs, int count) {
+    int16_t* values = accumulator.values[colorIndex(perspective)];
+    memcpy(values, network.inputBiases, NNUE_HIDDEN * sizeof(int16_t));
+    for (int i = 0; i < count; i++) {
+        addRow(values, network.inputWeights + size_t(inputs[i]) * NNUE_HIDDEN);
+    }
+    accumulator.dirty[colorIndex(perspective)] = false;
+}
+
+// ------------------------------------------------
+//                 DENSE LAYERS
+// ------------------------------------------------
+
+/**
+ * @brief Compute a hidden layer, each neuron giving its sum clamped between 0 and 127
+ * @param inputs The outputs of the previous layer
+ * @param inputCount The number of inputs, a multiple of 32
+ * @param layer The index of the hidden layer
+ * @param outputs The outputs of the layer
+*/
+static void hiddenLayer(const uint8_t* inputs, int inputCount, int layer, uint8_t* outputs) {
+    for (int neuron = 0; neuron < NNUE_DENSE; neuron++) {
+        int32_t sum = network.hiddenBiases[layer][neuron] + dotProduct(inputs, network.hiddenWeights[layer] + neuron * inputCount, inputCount);
+        outputs[neuron] = uint8_t(min(max(sum >> HIDDEN_SHIFT, 0), 127));
+    }
+}
+
+int evaluateNetwork(const Accumulator & accumulator, Color sideToMove) {
+    alignas(32) uint8_t transformed[2 * NNUE_HIDDEN];
+    alignas(32) uint8_t hidden[2][NNUE_DENSE];
+
+    // the accumulator of the player to move comes first, so the network knows who is to move
+    const int16_t* perspectives[2] = {accumulator.values[colorIndex(sideToMove)], accumulator.values[colorIndex(opponent(sideToMove))]};
+    for (int perspective = 0; perspective < 2; perspective++) {
+        for (int i = 0; i < NNUE_HIDDEN; i++) {
+            transformed[perspective * NNUE_HIDDEN + i] = uint8_t(min(max(int(perspectives[perspective][i]), 0), 127));
+        }
+    }
+
+    hiddenLayer(transformed, 2 * NNUE_HIDDEN, 0, hidden[0]);
+    hiddenLayer(hidden[0], NNUE_DENSE, 1, hidden[1]);
+
+    return (network.outputBias + dotProduct(hidden[1], network.outputWeights, NNUE_DENSE)) / OUTPUT_SCALE;
+}
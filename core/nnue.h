@@ -0,0 +1,108 @@
+/**
+ * @file nnue.h
+ * @brief Header file for the efficiently updatable neural network (NNUE) evaluating the positions
+ *
+ * The network sees the position from each player (perspective) with HalfKP features: one input for each
+ * piece other than the kings, by its color relative to the perspective, its type, its square and the square
+ * of the king of the perspective, Black seeing the board mirrored. The first layer sums the weights of the
+ * active inputs in an accumulator of each perspective, updated when a piece is put or removed; the two
+ * accumulators, side to move first, then go through two hidden layers and the output layer.
+ *
+ * The weights are read from a file mapped in memory, in little endian order:
+ * - the 8 bytes "ECHNNUE1"
+ * - the first layer: NNUE_HIDDEN int16 biases, then NNUE_HIDDEN int16 weights for each input
+ * - each hidden layer: NNUE_DENSE int32 biases, then the int8 weights of each neuron (2 * NNUE_HIDDEN, then NNUE_DENSE inputs)
+ * - the output layer: one int32 bias, then NNUE_DENSE int8 weights
+ */
+
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <cstdint>
+#include <string>
+
+#include "pieces.h"
+
+using namespace std;
+
+const int NNUE_INPUTS = 64 * 10 * 64;   ///< king square, then piece (color relative to the perspective and type) and square
+const int NNUE_HIDDEN = 128;            ///< size of the accumulator of each perspective
+const int NNUE_DENSE = 32;              ///< size of the hidden layers
+
+/**
+ * @struct Accumulator
+ * @brief Output of the first layer for each perspective, kept up to date with the pieces of the board
+*/
+struct Accumulator {
+    alignas(32) int16_t values[2][NNUE_HIDDEN];
+    bool dirty[2] = {true, true};   ///< true if the perspective must be computed again from the pieces (its king moved)
+};
+
+/**
+ * @brief true once a network is loaded, the board then keeps its accumulators up to date
+*/
+extern bool networkLoaded;
+
+/**
+ * @brief Map the weights of a network file in memory, replacing the network loaded before
+ * @param path The path of the file
+ * @return true if the network is loaded, false if the file can't be read or has not the expected size
+*/
+bool loadNetwork(const string & path);
+
+/**
+ * @brief Get the name of the instructions used for the layers, chosen according to the CPU when the network is loaded
+ * @return "AVX2", "SSE4.1" or "scalaire"
+*/
+const char* networkInstructions();
+
+/**
+ * @brief Get the input of a piece seen from a perspective
+ * @param perspective The color of the perspective
+ * @param kingSquare The square of the king of the perspective
+ * @param color The color of the piece
+ * @param type The type of the piece, not a king
+ * @param square The square of the piece
+ * @return The index of the input
+*/
+inline int networkInput(Color perspective, int kingSquare, Color color, PieceType type, int square) {
+    // Black sees the board with the lines reversed
+    int flip = perspective == Color::WHITE ? 0 : 56;
+    int piece = (color == perspective ? 0 : 5) + typeIndex(type);
+    return ((kingSquare ^ flip) * 10 + piece) * 64 + (square ^ flip);
+}
+
+/**
+ * @brief Add the weights of an input to the accumulator of a perspective
+ * @param accumulator The accumulators
+ * @param perspective The color of the perspective
+ * @param input The index of the input
+*/
+void addInput(Accumulator & accumulator, Color perspective, int input);
+
+/**
+ * @brief Remove the weights of an input from the accumulator of a perspective
+ * @param accumulator The accumulators
+ * @param perspective The color of the perspective
+ * @param input The index of the input
+*/
+void removeInput(Accumulator & accumulator, Color perspective, int input);
+
+/**
+ * @brief Compute the accumulator of a perspective from the biases and the inputs of the pieces, and mark it up to date
+ * @param accumulator The accumulators
+ * @param perspective The color of the perspective
+ * @param inputs The active inputs of the perspective
+ * @param count The number of inputs
+*/
+void refreshAccumulator(Accumulator & accumulator, Color perspective, const int* inputs, int count);
+
+/**
+ * @brief Run the layers after the first one on up to date accumulators
+ * @param accumulator The accumulators
+ * @param sideToMove The color of the player to move
+ * @return The score in centipawns, positive if the player to move is better
+*/
+int evaluateNetwork(const Accumulator & accumulator, Color sideToMove);
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file ordering.cpp
+ * @brief Implementation file for the move ordering of the search
+ */
+
+#include "ordering.h"
+
+#include "evaluate.h"
+
+// the scores of each group of moves, the groups not overlapping
+static const int HASH_MOVE_SCORE = 1 << 30;
+static const int CAPTURE_SCORE = 1 << 28;
+static const int KILLER_SCORE = 1 << 27;
+static const int COUNTER_MOVE_SCORE = (1 << 27) - 2;
+static const int HISTORY_LIMIT = 1 << 24;
+static const int LOSING_CAPTURE_SCORE = -(1 << 28);
+
+bool isTactical(const Board & board, Move move) {
+    return
+        move.getKind() == MoveKind::EN_PASSANT ||
+        move.getKind() == MoveKind::PROMOTION ||
+        board.getPosition().isOccupied(move.getTo());
+}
+
+bool losesExchange(const Board & board, Move move) {
+    // taking a piece at least as valuable as the attacker can't lose material, no need to resolve the exchange
+    Piece victim = board.getPiece(move.getTo());
+    if (
+        move.getKind() == MoveKind::NORMAL && !victim.isEmpty() &&
+        PIECE_VALUES[typeIndex(victim.getType())] >= PIECE_VALUES[typeIndex(board.getPiece(move.getFrom()).getType())]
+    ) {
+        return false;
+    }
+
+    return staticExchange(board, move) < 0;
+}
+
+// ------------------------------------------------
+//                ORDERING TABLES
+// ------------------------------------------------
+
+/**
+ * @brief Move a history score toward the limit, the bonus shrinking as the score grows so it never overflows
+*/
+static void addHistory(int & score, int bonus) {
+    score += bonus - score * abs(bonus) / HISTORY_LIMIT;
+}
+
+void OrderingTables::updateQuietCutoff(const Board & board, Move move, const Move* tried, int triedCount, int depth, int ply) {
+    if (killers[ply][0] != move) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+
+    Move previous = board.getLastMove();
+    if (previous != Move()) {
+        counterMoves[previous.getFrom()][previous.getTo()] = move;
+    }
+
+    int (&table)[64][64] = history[colorIndex(board.getSideToMove())];
+    int bonus = min(depth * depth, 400);
+    addHistory(table[move.getFrom()][move.getTo()], bonus);
+    for (int i = 0; i < triedCount; i++) {
+        addHistory(table[tried[i].getFrom()][tried[i].getTo()], -bonus);
+    }
+}
+
+// ------------------------------------------------
+//                  MOVE PICKER
+// ------------------------------------------------
+
+MovePicker::MovePicker(const Board & board, const OrderingTables & tables, Move hashMove, int ply) {
+    board.generateLegalMoves(moves);
+
+    const int (&history)[64][64] = tables.history[colorIndex(board.getSideToMove())];
+    Move previous = board.getLastMove();
+    Move counterMove = previous != Move() ? tables.counterMoves[previous.getFrom()][previous.getTo()] : Move();
+
+    for (int i = 0; i < moves.size(); i++) {
+        Move move = moves[i];
+        if (move == hashMove) {
+            scores[i] = HASH_MOVE_SCORE;
+        } else if (isTactical(board, move)) {
+            // most valuable victim first, then least valuable attacker, the promotion adding the new piece
+            Piece victim = board.getPiece(move.getTo());
+            int victimValue = move.getKind() == MoveKind::EN_PASSANT ? PIECE_VALUES[typeIndex(PieceType::PAWN)] : victim.isEmpty() ? 0 : PIECE_VALUES[typeIndex(victim.getType())];
+            int promotionValue = move.getKind() == MoveKind::PROMOTION ? PIECE_VALUES[typeIndex(move.getPromotion())] : 0;
+            int attacker = typeIndex(board.getPiece(move.getFrom()).getType());
+            scores[i] = (losesExchange(board, move) ? LOSING_CAPTURE_SCORE : CAPTURE_SCORE) + (victimValue + promotionValue) * 8 - attacker;
+        } else if (move == tables.killers[ply][0]) {
+            scores[i] = KILLER_SCORE;
+        } else if (move == tables.killers[ply][1]) {
+            scores[i] = KILLER_SCORE - 1;
+        } else if (move == counterMove) {
+            scores[i] = COUNTER_MOVE_SCORE;
+        } else {
+            scores[i] = history[move.getFrom()][move.getTo()];
+        }
+    }
+}
+
+int MovePicker::size() const {
+    return moves.size();
+}
+
+bool MovePicker::next(Move & move) {
+    if (current >= moves.size()) {
+        return false;
+    }
+
+    // bring the best of the remaining moves to the current place
+    int best = current;
+    for (int i = current + 1; i < moves.size(); i++) {
+        if (scores[i] > scores[best]) {
+            best = i;
+        }
+    }
+    swap(moves[current], moves[best]);
+    swap(scores[current], scores[best]);
+
+    move = moves[current++];
+    return true;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file ordering.h
+ * @brief Header file for the move ordering of the search, trying the moves most likely to be the best first
+ */
+
+#ifndef ORDERING_H
+#define ORDERING_H
+
+#include "board.h"
+#include "move.h"
+#include "search.h"
+
+using namespace std;
+
+/**
+ * @struct OrderingTables
+ * @brief What a search thread learns about the good moves, to try them earlier in the other positions
+*/
+struct OrderingTables {
+    Move killers[MAX_PLY][2] = {};      ///< last two quiet moves that caused a cutoff at each ply
+    int history[2][64][64] = {};        ///< butterfly table: score of the quiet moves by color, start and end
+    Move counterMoves[64][64] = {};     ///< quiet move that refuted each previous move, by its start and end
+
+    /**
+     * @brief Remember a quiet move that caused a cutoff and lower the score of the quiet moves tried before it
+     * @param board The board, before the move
+     * @param move The move that caused the cutoff
+     * @param tried The quiet moves tried before it
+     * @param triedCount The number of quiet moves tried before it
+     * @param depth The remaining depth of the node
+     * @param ply The distance to the root
+    */
+    void updateQuietCutoff(const Board & board, Move move, const Move* tried, int triedCount, int depth, int ply);
+};
+
+/**
+ * @class MovePicker
+ * @brief Give the moves of a position one by one, the most promising first
+ *
+ * The table or principal variation move comes first, then the captures and promotions by most valuable victim
+ * and least valuable attacker, then the two killer moves of the ply, the counter move of the previous move and
+ * the other quiet moves by history score, and last the captures and promotions losing material in the exchange.
+ * The next move is selected when asked, so the moves after a cutoff are never sorted.
+*/
+class MovePicker {
+private:
+    MoveList moves;
+    int scores[256];
+    int current = 0;
+public:
+    /**
+     * @brief Generate and score the legal moves of the player to move
+     * @param board The board
+     * @param tables The tables of the search thread
+     * @param hashMove The move of the table or of the principal variation, may be empty
+     * @param ply The distance to the root
+    */
+    MovePicker(const Board & board, const OrderingTables & tables, Move hashMove, int ply);
+
+    /**
+     * @brief Get the number of legal moves
+     * @return The number of legal moves
+    */
+    int size() const;
+
+    /**
+     * @brief Get the next most promising move
+     * @param move The move, set if there is one left
+     * @return true if a move is given, false if every move was given
+    */
+    bool next(Move & move);
+};
+
+/**
+ * @brief Check if a move takes a piece or promotes a pawn
+ * @param board The board, before the move
+ * @param move The move
+ * @return true if the move is not a quiet move, false otherwise
+*/
+bool isTactical(const Board & board, Move move);
+
+/**
+ * @brief Check if a capture or a promotion loses material once the exchanges on its end square are played
+ * @param board The board, before the move
+ * @param move The move
+ * @return true if the static exchange evaluation of the move is negative, false otherwise
+*/
+bool losesExchange(const Board & board, Move move);
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * @file pawns.cpp
+ * @brief Implementation file for the pawn structure analysis and its hash table
+ */
+
+#include "pawns.h"
+
+// ------------------------------------------------
+//                 PAWN MASKS
+// ------------------------------------------------
+
+/**
+ * @brief Get the squares of a column
+*/
+static Bitboard columnMask(int column) {
+    return 0x0101010101010101ULL << column;
+}
+
+/**
+ * @brief Get the squares of the columns beside a column
+*/
+static Bitboard adjacentColumns(int column) {
+    return (column > 0 ? columnMask(column - 1) : 0) | (column < 7 ? columnMask(column + 1) : 0);
+}
+
+/**
+ * @brief Get the squares of the lines in front of a square, seen by a color
+*/
+static Bitboard linesInFront(Color color, int square) {
+    int line = squareLine(square);
+    if (color == Color::WHITE) {
+        return line == 7 ? 0 : ~Bitboard(0) << (8 * (line + 1));
+    }
+    return line == 0 ? 0 : ~Bitboard(0) >> (8 * (8 - line));
+}
+
+// ------------------------------------------------
+//                   ANALYSIS
+// ------------------------------------------------
+
+PawnEntry analyzePawnStructure(const Position & position, HashKey key) {
+    PawnEntry entry;
+    entry.key = key;
+
+    for (Color color : {Color::WHITE, Color::BLACK}) {
+        int sign = color == Color::WHITE ? 1 : -1;
+        Bitboard ours = position.getPieces(color, PieceType::PAWN);
+        Bitboard theirs = position.getPieces(opponent(color), PieceType::PAWN);
+
+        Bitboard pawns = ours;
+        while (pawns) {
+            int square = popLsb(pawns);
+            int column = squareColumn(square);
+            Bitboard inFront = linesInFront(color, square);
+            Bitboard neighbours = ours & adjacentColumns(column);
+            int terms[PAWN_TERMS] = {};
+
+            terms[DOUBLED_PAWN] = (ours & columnMask(column) & inFront) != 0;
+            terms[ISOLATED_PAWN] = neighbours == 0;
+
+            // no pawn beside it can come to protect it, and it can't move forward safely
+            int stop = square + (color == Color::WHITE ? 8 : -8);
+            terms[BACKWARD_PAWN] =
+                neighbours != 0 &&
+                (neighbours & ~inFront) == 0 &&
+                (pawnAttacks(color, stop) & theirs) != 0;
+
+            for (int stage = 0; stage < 2; stage++) {
+                for (int term = DOUBLED_PAWN; term <= BACKWARD_PAWN; term++) {
+                    entry.scores[stage] += sign * terms[term] * pawnTermScores[stage][term];
+                }
+            }
+
+            // no opponent pawn can stop it, and it is the first pawn of its column
+            Bitboard stoppers = theirs & (columnMask(column) | adjacentColumns(column)) & inFront;
+            if (!stoppers && !terms[DOUBLED_PAWN]) {
+                entry.passed[colorIndex(color)] |= squareBit(square);
+                int line = color == Color::WHITE ? squareLine(square) : 7 - squareLine(square);
+                entry.scores[MIDDLEGAME] += sign * passedPawnScores[MIDDLEGAME][line];
+                entry.scores[ENDGAME] += sign * passedPawnScores[ENDGAME][line];
+            }
+        }
+    }
+
+    return entry;
+}
+
+int kingShield(PawnEntry & entry, const Position & position, Color color, int kingSquare) {
+    int index = colorIndex(color);
+    if (entry.shieldKings[index] == kingSquare) {
+        return entry.shields[index];
+    }
+
+    Bitboard ours = position.getPieces(color, PieceType::PAWN);
+    int forward = color == Color::WHITE ? 1 : -1;
+    int kingLine = squareLine(kingSquare);
+    int kingColumn = squareColumn(kingSquare);
+
+    int shield = 0;
+    for (int column = max(0, kingColumn - 1); column <= min(7, kingColumn + 1); column++) {
+        int near = kingLine + forward;
+        int far = kingLine + 2 * forward;
+        if (near >= 0 && near < 8 && (ours & squareBit(squareIndex(near, column)))) {
+            shield += pawnTermScores[MIDDLEGAME][SHIELD_NEAR];
+        } else if (far >= 0 && far < 8 && (ours & squareBit(squareIndex(far, column)))) {
+            shield += pawnTermScores[MIDDLEGAME][SHIELD_FAR];
+        }
+    }
+
+    entry.shieldKings[index] = kingSquare;
+    entry.shields[index] = shield;
+    return shield;
+}
+
+// ------------------------------------------------
+//                  PAWN TABLE
+// ------------------------------------------------
+
+PawnTable::PawnTable(size_t size) : entries(size) {}
+
+PawnEntry & PawnTable::probe(HashKey key, const Position & position) {
+    PawnEntry & entry = entries[key & (entries.size() - 1)];
+    if (entry.key == key) {
+        return entry;
+    }
+
+    entry = analyzePawnStructure(position, key);
+    return entry;
+}
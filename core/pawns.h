@@ -0,0 +1,70 @@
+/**
+ * @file pawns.h
+ * @brief Header file for the pawn structure analysis and its hash table
+ */
+
+#ifndef PAWNS_H
+#define PAWNS_H
+
+#include <vector>
+
+#include "position.h"
+#include "weights.h"
+#include "zobrist.h"
+
+using namespace std;
+
+/**
+ * @struct PawnEntry
+ * @brief Analysis of a pawn structure, which only changes when a pawn moves, is taken or promotes
+*/
+struct PawnEntry {
+    HashKey key = 0;                    ///< pawn key of the structure
+    int scores[2] = {0, 0};             ///< doubled, isolated, backward and passed pawns by stage, positive if White is better
+    Bitboard passed[2] = {0, 0};        ///< passed pawns of each color
+    int shieldKings[2] = {-1, -1};      ///< king squares the shields were computed for
+    int shields[2] = {0, 0};            ///< middlegame bonus of the pawns shielding each king
+};
+
+/**
+ * @brief Analyze the pawn structure of a position
+ * @param position The position
+ * @param key The pawn key of the position
+ * @return The analysis, without the king shields
+*/
+PawnEntry analyzePawnStructure(const Position & position, HashKey key);
+
+/**
+ * @brief Get the bonus of the pawns shielding a king, computed once for each king square of an entry
+ * @param entry The analysis of the pawn structure
+ * @param position The position
+ * @param color The color of the king
+ * @param kingSquare The square of the king
+ * @return The middlegame bonus of the shield of the king
+*/
+int kingShield(PawnEntry & entry, const Position & position, Color color, int kingSquare);
+
+/**
+ * @class PawnTable
+ * @brief Small hash table of the pawn structures analyzed by a search thread, indexed by pawn key
+*/
+class PawnTable {
+private:
+    vector<PawnEntry> entries;
+public:
+    /**
+     * @brief Create an empty table
+     * @param size The number of entries, a power of 2
+    */
+    explicit PawnTable(size_t size = 1 << 14);
+
+    /**
+     * @brief Get the analysis of the pawn structure of a position, analyzing it if it is not in the table
+     * @param key The pawn key of the position
+     * @param position The position
+     * @return The entry of the structure, valid until the next probe
+    */
+    PawnEntry & probe(HashKey key, const Position & position);
+};
+
+#endif
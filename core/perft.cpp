@@ -0,0 +1,187 @@
+/**
+ * @file perft.cpp
+ * @brief Implementation file for the perft node counting
+ */
+
+#include "perft.h"
+
+#include <thread>
+#include <vector>
+
+// ------------------------------------------------
+//                  PERFT TABLE
+// ------------------------------------------------
+
+PerftTable::PerftTable(size_t megabytes) {
+    size_t size = 1;
+    while (size * 2 * sizeof(Entry) <= megabytes * 1024 * 1024) {
+        size *= 2;
+    }
+
+    // a zeroed entry holds depth 0, which is never looked for
+    entries = make_unique<Entry[]>(size);
+    mask = size - 1;
+}
+
+/**
+ * @brief Get the slot of a subtree, the same position at different depths going to different slots
+*/
+static size_t slotIndex(HashKey key, int depth, size_t mask) {
+    return (key ^ (uint64_t(depth) * 0x9E3779B97F4A7C15ULL)) & mask;
+}
+
+bool PerftTable::probe(HashKey key, int depth, uint64_t & nodes) const {
+    const Entry & entry = entries[slotIndex(key, depth, mask)];
+    uint64_t data = entry.data.load(memory_order_relaxed);
+    uint64_t check = entry.check.load(memory_order_relaxed);
+
+    if ((check ^ data) != key || int(data & 0xFF) != depth) {
+        return false;
+    }
+
+    nodes = data >> 8;
+    return true;
+}
+
+void PerftTable::store(HashKey key, int depth, uint64_t nodes) {
+    Entry & entry = entries[slotIndex(key, depth, mask)];
+    uint64_t data = nodes << 8 | uint64_t(depth);
+    entry.check.store(key ^ data, memory_order_relaxed);
+    entry.data.store(data, memory_order_relaxed);
+}
+
+// ------------------------------------------------
+//                  NODE COUNTING
+// ------------------------------------------------
+
+uint64_t perft(Board & board, int depth, PerftTable * table) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    uint64_t nodes = 0;
+    if (table && depth > 1 && table->probe(board.getHashKey(), depth, nodes)) {
+        return nodes;
+    }
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+
+    // bulk counting: the moves of the last level don't need to be played
+    if (depth == 1) {
+        return moves.size();
+    }
+
+    for (Move move : moves) {
+        board.makeMove(move);
+        nodes += perft(board, depth - 1, table);
+        board.unmakeMove();
+    }
+
+    if (table) {
+        table->store(board.getHashKey(), depth, nodes);
+    }
+
+    return nodes;
+}
+
+/**
+ * @struct PerftTask
+ * @brief Subtree counted by one thread: a first move, eventually followed by an answer
+*/
+struct PerftTask {
+    int root;       ///< index of the first move in the list of the position
+    Move answer;    ///< move answering the first one
+    bool hasAnswer; ///< false if the subtree starts right after the first move
+};
+
+/**
+ * @brief Count the leaf nodes under each legal move of the position, sharing the subtrees between threads
+ * @param board The board
+ * @param depth The depth of the tree, at least 1
+ * @param moves The legal moves of the position
+ * @param threads The number of threads
+ * @param table The table shared by the threads, nullptr to count everything
+ * @return The node count under each move, in the order of the list
+*/
+static vector<uint64_t> countRootMoves(const Board & board, int depth, const MoveList & moves, int threads, PerftTable * table) {
+    // the answers are split too when the tree is deep enough, so that a big subtree doesn't keep one thread busy
+    vector<PerftTask> tasks;
+    Board setup = board;
+    for (int i = 0; i < moves.size(); i++) {
+        if (depth < 3) {
+            tasks.push_back({i, Move(), false});
+            continue;
+        }
+
+        setup.makeMove(moves[i]);
+        MoveList answers;
+        setup.generateLegalMoves(answers);
+        for (Move answer : answers) {
+            tasks.push_back({i, answer, true});
+        }
+        setup.unmakeMove();
+    }
+
+    // each thread takes the next task until there is none left
+    vector<atomic<uint64_t>> counts(moves.size());
+    atomic<size_t> next(0);
+    auto worker = [&]() {
+        Board copy = board;
+        for (size_t task = next++; task < tasks.size(); task = next++) {
+            const PerftTask & current = tasks[task];
+            copy.makeMove(moves[current.root]);
+            if (current.hasAnswer) {
+                copy.makeMove(current.answer);
+                counts[current.root] += perft(copy, depth - 2, table);
+                copy.unmakeMove();
+            } else {
+                counts[current.root] += perft(copy, depth - 1, table);
+            }
+            copy.unmakeMove();
+        }
+    };
+
+    vector<thread> pool;
+    for (int i = 1; i < threads; i++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (thread & t : pool) {
+        t.join();
+    }
+
+    return vector<uint64_t>(counts.begin(), counts.end());
+}
+
+uint64_t perftParallel(const Board & board, int depth, int threads, PerftTable * table) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+
+    uint64_t total = 0;
+    for (uint64_t nodes : countRootMoves(board, depth, moves, threads, table)) {
+        total += nodes;
+    }
+
+    return total;
+}
+
+uint64_t perftDivide(const Board & board, int depth, ostream & out, int threads, PerftTable * table) {
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    vector<uint64_t> counts = countRootMoves(board, depth, moves, threads, table);
+
+    uint64_t total = 0;
+    char text[6];
+    for (int i = 0; i < moves.size(); i++) {
+        moves[i].write(text);
+        out << text << ": " << counts[i] << endl;
+        total += counts[i];
+    }
+
+    return total;
+}
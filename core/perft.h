@@ -0,0 +1,90 @@
+/**
+ * @file perft.h
+ * @brief Header file for the perft node counting, used to check and time the move generation
+ */
+
+#ifndef PERFT_H
+#define PERFT_H
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+#include "board.h"
+#include "zobrist.h"
+
+using namespace std;
+
+/**
+ * @class PerftTable
+ * @brief Hash table of the node counts of the subtrees, shared by the threads without lock
+ *
+ * Each entry stores the count with its depth, and the key of the position XORed with them: an entry
+ * half written by another thread doesn't match the key anymore and is ignored.
+*/
+class PerftTable {
+private:
+    struct Entry {
+        atomic<uint64_t> check;  ///< key of the position XOR data
+        atomic<uint64_t> data;   ///< node count in the high bits, depth in the 8 low bits
+    };
+
+    unique_ptr<Entry[]> entries;
+    size_t mask;
+public:
+    /**
+     * @brief Allocate an empty table
+     * @param megabytes The size of the table, rounded down to a power of two entries
+    */
+    PerftTable(size_t megabytes);
+
+    /**
+     * @brief Look for the node count of a subtree
+     * @param key The key of the position
+     * @param depth The depth of the subtree
+     * @param nodes The node count, set if it is found
+     * @return true if the count is found, false otherwise
+    */
+    bool probe(HashKey key, int depth, uint64_t & nodes) const;
+
+    /**
+     * @brief Save the node count of a subtree, replacing the previous entry
+     * @param key The key of the position
+     * @param depth The depth of the subtree
+     * @param nodes The node count
+    */
+    void store(HashKey key, int depth, uint64_t nodes);
+};
+
+/**
+ * @brief Count the leaf nodes of the legal move tree, the last level is counted from the size of the move lists
+ * @param board The board, left unchanged
+ * @param depth The depth of the tree
+ * @param table The table to reuse the counts of the subtrees already seen, nullptr to count everything
+ * @return The number of leaf nodes
+*/
+uint64_t perft(Board & board, int depth, PerftTable * table = nullptr);
+
+/**
+ * @brief Count the leaf nodes of the legal move tree, the moves of the first two levels are shared between threads
+ * @param board The board
+ * @param depth The depth of the tree
+ * @param threads The number of threads
+ * @param table The table shared by the threads, nullptr to count everything
+ * @return The number of leaf nodes
+*/
+uint64_t perftParallel(const Board & board, int depth, int threads, PerftTable * table = nullptr);
+
+/**
+ * @brief Count the leaf nodes under each legal move of the position and print them ("e2e4: 20")
+ * @param board The board
+ * @param depth The depth of the tree, at least 1
+ * @param out The stream to print the counts to
+ * @param threads The number of threads
+ * @param table The table shared by the threads, nullptr to count everything
+ * @return The total number of leaf nodes
+*/
+uint64_t perftDivide(const Board & board, int depth, ostream & out, int threads = 1, PerftTable * table = nullptr);
+
+#endif
@@ -0,0 +1,369 @@
+/**
+ * @file pgn.cpp
+ * @brief Implementation file for the PGN reader and the SAN decoding
+ */
+
+#include "pgn.h"
+
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @enum CharClass
+ * @brief Kind of a character of the movetext, read from a table rather than with isspace and strchr
+*/
+enum CharClass : uint8_t {
+    TOKEN_CHAR,
+    SPACE_CHAR,
+    DELIMITER_CHAR  ///< starts or ends a tag, a comment or a variation
+};
+
+static const array<uint8_t, 256> CHAR_CLASSES = [] {
+    array<uint8_t, 256> classes{};
+    for (unsigned char c : string(" \t\n\r\v\f")) {
+        classes[c] = SPACE_CHAR;
+    }
+    for (unsigned char c : string("{}()[];")) {
+        classes[c] = DELIMITER_CHAR;
+    }
+    return classes;
+}();
+
+/**
+ * @brief Get the kind of a character
+ * @param c The character
+ * @return The kind of the character
+*/
+static inline uint8_t charClass(char c) {
+    return CHAR_CLASSES[static_cast<unsigned char>(c)];
+}
+
+string_view PgnGame::tag(string_view name) const {
+    for (const PgnTag & pair : tags) {
+        if (pair.name == name) {
+            return pair.value;
+        }
+    }
+    return string_view();
+}
+
+// ------------------------------------------------
+//                    READER
+// ------------------------------------------------
+
+PgnReader::~PgnReader() {
+    if (mapping) {
+        munmap(mapping, size);
+    }
+}
+
+bool PgnReader::open(const string & path) {
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file == -1) {
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) == -1) {
+        close(file);
+        return false;
+    }
+
+    if (mapping) {
+        munmap(mapping, size);
+        mapping = nullptr;
+    }
+    data = nullptr;
+    size = status.st_size;
+    offset = released = 0;
+
+    // an empty file has no game, and can't be mapped
+    if (size == 0) {
+        close(file);
+        return true;
+    }
+
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED) {
+        size = 0;
+        return false;
+    }
+
+    // the file is read once from the start to the end, the system can read ahead
+    madvise(view, size, MADV_SEQUENTIAL);
+    mapping = view;
+    data = static_cast<const char*>(view);
+    return true;
+}
+
+void PgnReader::skipLine() {
+    while (offset < size && data[offset] != '\n') {
+        offset++;
+    }
+}
+
+void PgnReader::skipGroup() {
+    int depth = 0;
+    while (offset < size) {
+        char c = data[offset++];
+        if (c == '{') {
+            // a comment ends at the first closing brace, whatever it holds
+            while (offset < size && data[offset] != '}') {
+                offset++;
+            }
+            offset = min(offset + 1, size);
+            if (depth == 0) {
+                return;
+            }
+        } else if (c == ';') {
+            skipLine();
+        } else if (c == '(') {
+            depth++;
+        } else if (c == ')' && --depth == 0) {
+            return;
+        }
+    }
+}
+
+void PgnReader::readTag(PgnGame & game) {
+    offset++;
+    while (offset < size && charClass(data[offset]) == SPACE_CHAR) {
+        offset++;
+    }
+
+    size_t start = offset;
+    while (offset < size && charClass(data[offset]) != SPACE_CHAR && data[offset] != '"' && data[offset] != ']') {
+        offset++;
+    }
+    string_view name(data + start, offset - start);
+
+    string_view value;
+    while (offset < size && data[offset] != '"' && data[offset] != ']') {
+        offset++;
+    }
+    if (offset < size && data[offset] == '"') {
+        start = ++offset;
+        while (offset < size && data[offset] != '"') {
+            offset += data[offset] == '\\' ? 2 : 1;
+        }
+        offset = min(offset, size);
+        value = string_view(data + start, offset - start);
+    }
+
+    while (offset < size && data[offset] != ']') {
+        offset++;
+    }
+    offset = min(offset + 1, size);
+
+    game.tags.push_back({name, value});
+}
+
+bool PgnReader::nextGame(PgnGame & game) {
+    game.tags.clear();
+    game.moves.clear();
+    game.result = string_view();
+
+    // the previous game is not used anymore, the pages before it are given back once there are enough of them
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t readEnd = offset / page * page;
+    if (readEnd - released >= PGN_RELEASE_BYTES) {
+        madvise(const_cast<char*>(data) + released, readEnd - released, MADV_DONTNEED);
+        released = readEnd;
+    }
+
+    bool started = false;
+    while (offset < size) {
+        char c = data[offset];
+        if (charClass(c) == SPACE_CHAR) {
+            offset++;
+        } else if (c == ';' || (c == '%' && (offset == 0 || data[offset - 1] == '\n'))) {
+            skipLine();
+        } else if (c == '{' || c == '(') {
+            skipGroup();
+        } else if (c == ')' || c == '}' || c == ']') {
+            offset++;
+        } else if (c == '[') {
+            // the tags of the next game end a game without result
+            if (!game.moves.empty()) {
+                return true;
+            }
+            readTag(game);
+            started = true;
+        } else {
+            size_t start = offset;
+            while (offset < size && charClass(data[offset]) == TOKEN_CHAR) {
+                offset++;
+            }
+            string_view token(data + start, offset - start);
+            started = true;
+
+            if (token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*") {
+                game.result = token;
+                return true;
+            }
+
+            // numeric annotation glyphs ($1) and move numbers ("12.", "12...", "12.e4") are left out
+            if (token[0] == '$') {
+                continue;
+            }
+            size_t digits = 0;
+            while (digits < token.size() && isdigit(static_cast<unsigned char>(token[digits]))) {
+                digits++;
+            }
+            if (digits < token.size() && token[digits] == '.') {
+                token.remove_prefix(digits);
+            }
+            while (!token.empty() && token[0] == '.') {
+                token.remove_prefix(1);
+            }
+
+            if (!token.empty()) {
+                game.moves.push_back(token);
+            }
+        }
+    }
+
+    return started;
+}
+
+// ------------------------------------------------
+//                  SAN DECODING
+// ------------------------------------------------
+
+Move parseSan(const Board & board, string_view san) {
+    while (!san.empty() && strchr("+#!?", san.back())) {
+        san.remove_suffix(1);
+    }
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+
+    // castling, the king moving two squares to the side of its rook
+    if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0") {
+        bool kingside = san.size() == 3;
+        for (Move move : moves) {
+            if (move.getKind() == MoveKind::CASTLING && (move.getTo() > move.getFrom()) == kingside) {
+                return move;
+            }
+        }
+        return Move();
+    }
+
+    // piece moved, pawn if its letter is not given
+    PieceType type = PieceType::PAWN;
+    static const string pieceLetters = "NBRQK";
+    if (!san.empty() && pieceLetters.find(san[0]) != string::npos) {
+        type = static_cast<PieceType>(pieceLetters.find(san[0]) + static_cast<int>(PieceType::KNIGHT));
+        san.remove_prefix(1);
+    }
+
+    // promotion piece, with or without the equal sign, only valid on a promotion
+    PieceType promotion = PieceType::QUEEN;
+    bool promotionGiven = false;
+    if (!san.empty() && pieceLetters.find(san.back()) != string::npos && san.back() != 'K') {
+        promotionGiven = true;
+        promotion = static_cast<PieceType>(pieceLetters.find(san.back()) + static_cast<int>(PieceType::KNIGHT));
+        san.remove_suffix(1);
+        if (!san.empty() && san.back() == '=') {
+            san.remove_suffix(1);
+        }
+    }
+
+    if (san.size() < 2 || san[san.size() - 2] < 'a' || san[san.size() - 2] > 'h' || san.back() < '1' || san.back() > '8') {
+        return Move();
+    }
+    int to = squareIndex(san.back() - '1', san[san.size() - 2] - 'a');
+    san.remove_suffix(2);
+
+    // what is left tells the column or the line of the start square, and the capture
+    int fromColumn = -1;
+    int fromLine = -1;
+    for (char c : san) {
+        if (c >= 'a' && c <= 'h') {
+            fromColumn = c - 'a';
+        } else if (c >= '1' && c <= '8') {
+            fromLine = c - '1';
+        } else if (c != 'x' && c != ':' && c != '-') {
+            return Move();
+        }
+    }
+
+    Move found;
+    int matches = 0;
+    for (Move move : moves) {
+        int from = move.getFrom();
+        if (move.getTo() != to || board.getPiece(from).getType() != type ||
+            (fromColumn != -1 && squareColumn(from) != fromColumn) || (fromLine != -1 && squareLine(from) != fromLine) ||
+            (move.getKind() == MoveKind::PROMOTION && move.getPromotion() != promotion) ||
+            (move.getKind() != MoveKind::PROMOTION && promotionGiven) ||
+            move.getKind() == MoveKind::CASTLING) {
+            continue;
+        }
+
+        found = move;
+        matches++;
+    }
+
+    return matches == 1 ? found : Move();
+}
+
+// ------------------------------------------------
+//                    REPLAY
+// ------------------------------------------------
+
+long replayPgn(const string & path, ostream & output) {
+    PgnReader reader;
+    if (!reader.open(path)) {
+        return -1;
+    }
+
+    // the end of the game is found by the board as in the game loop, its messages being dropped
+    Board board;
+    ostream silent(nullptr);
+    board.setStreams(cin, silent, false);
+
+    PgnGame game;
+    long games = 0;
+    while (reader.nextGame(game)) {
+        games++;
+
+        // the moves of a game starting from an invalid position can't be decoded, its line is left empty
+        string_view fen = game.tag("FEN");
+        if (fen.empty()) {
+            board.loadFen(STARTING_FEN);
+        } else if (!board.loadFen(string(fen))) {
+            cerr << "FEN invalide dans la partie " << games << ": " << fen << endl;
+            output << '\n';
+            continue;
+        }
+
+        // no move is legal after a checkmate or a stalemate, the end of the game is only looked for after the
+        // last move, the players being free to go on after a repetition
+        string_view lastMove;
+        for (string_view san : game.moves) {
+            Move move = parseSan(board, san);
+            if (move == Move()) {
+                cerr << "Coup invalide dans la partie " << games << ": " << san << endl;
+                break;
+            }
+
+            board.makeMove(move);
+            lastMove = san;
+        }
+
+        if (!lastMove.empty()) {
+            board.concludeMove(string(lastMove), board.getSideToMove() == Color::BLACK);
+        }
+
+        output << board.canonical_position() << '\n';
+    }
+
+    output.flush();
+    return games;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file pgn.h
+ * @brief Header file for the PGN reader, streaming the games of a mapped file and decoding their SAN moves
+ */
+
+#ifndef PGN_H
+#define PGN_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "board.h"
+
+using namespace std;
+
+/**
+ * @brief Bytes read between two releases of the pages of the file already read
+*/
+const size_t PGN_RELEASE_BYTES = 64 << 20;
+
+/**
+ * @struct PgnTag
+ * @brief Tag pair of a game ([Name "Value"]), pointing in the mapped file
+*/
+struct PgnTag {
+    string_view name;
+    string_view value;  ///< value between the quotes, escaped characters left as they are
+};
+
+/**
+ * @struct PgnGame
+ * @brief Game read from a PGN file, its texts pointing in the mapped file until the next game is read
+*/
+struct PgnGame {
+    vector<PgnTag> tags;
+    vector<string_view> moves;  ///< moves in SAN ("Nbd7", "exd8=Q+"), without the move numbers, comments and variations
+    string_view result;         ///< "1-0", "0-1", "1/2-1/2" or "*", empty if the game has no result
+
+    /**
+     * @brief Get the value of a tag
+     * @param name The name of the tag
+     * @return The value of the tag, empty if the game doesn't have it
+    */
+    string_view tag(string_view name) const;
+};
+
+/**
+ * @class PgnReader
+ * @brief Reader of the games of a PGN file, one at a time
+ *
+ * The file is mapped in memory and the tags and moves are cut in place, without copy. The pages already read are
+ * given back to the system as the reading goes, so that a file of any size is read with constant memory.
+*/
+class PgnReader {
+private:
+    void* mapping = nullptr;
+    const char* data = nullptr;
+    size_t size = 0;
+    size_t offset = 0;      ///< start of the next game
+    size_t released = 0;    ///< end of the pages given back to the system
+
+    /**
+     * @brief Skip the text up to the end of the line
+    */
+    void skipLine();
+
+    /**
+     * @brief Skip a comment between braces or a variation between parentheses, the variations being nested
+    */
+    void skipGroup();
+
+    /**
+     * @brief Read the tag pair starting at the offset
+     * @param game The game to add the tag to
+    */
+    void readTag(PgnGame & game);
+public:
+    PgnReader() = default;
+    PgnReader(const PgnReader &) = delete;
+    PgnReader & operator=(const PgnReader &) = delete;
+    ~PgnReader();
+
+    /**
+     * @brief Map a PGN file to read its games from the start
+     * @param path The path of the file
+     * @return true if the file is mapped, false if it can't be read
+    */
+    bool open(const string & path);
+
+    /**
+     * @brief Read the next game, a game without result ending where the tags of the next one start
+     * @param game Filled with the game, its vectors keeping their capacity from one game to the next
+     * @return true if a game is read, false at the end of the file
+    */
+    bool nextGame(PgnGame & game);
+};
+
+/**
+ * @brief Find the legal move written in Standard Algebraic Notation
+ *
+ * The check and annotation marks (+, #, !, ?) are ignored, castling may be written with O or 0, and a promotion
+ * without its piece ("e8") is a queen promotion. A promotion piece given to a move that is not a promotion ("Nf3Q")
+ * matches no move.
+ * @param board The board, the move being played by the player to move
+ * @param san The move ("e4", "Nbd7", "exd8=Q+", "O-O-O")
+ * @return The legal move, an empty move (Move()) if there is no legal move or more than one matching it
+*/
+Move parseSan(const Board & board, string_view san);
+
+/**
+ * @brief Play all the games of a PGN file without display, writing one result line for each game
+ *
+ * Each game starts from its FEN tag or from the starting position, and is played until its last move or its
+ * first move that can't be decoded, which is reported on the error stream. A game with an invalid FEN tag is
+ * reported the same way and skipped, its line being left empty.
+ * @param path The path of the PGN file
+ * @param output The stream of the canonical positions of the end of the games with their result
+ * @return The number of games, -1 if the file can't be read
+*/
+long replayPgn(const string & path, ostream & output);
+
+#endif
@@ -6,48 +6,36 @@
 #include "pieces.h"
 
 // ------------------------------------------------
-//                 GETTERS & SETTERS
+//                    SQUARE
 // ------------------------------------------------
 
-int Square::getLine() const {
-    return line;
-}
-
-int Square::getColumn() const {
-    return column;
-}
+// names of the columns and lines, indexed by their number
+static const char columnNames[9] = "abcdefgh";
+static const char lineNames[9] = "12345678";
 
-string Square::toString() const {
-    string str = "";
-    str += column + 'a';
-    str += line + '1';
-    return str;
+char* Square::write(char* buffer) const {
+    buffer[0] = columnNames[getColumn()];
+    buffer[1] = lineNames[getLine()];
+    buffer[2] = '\0';
+    return buffer + 2;
 }
 
-string Piece::getIcon() const {
-    return name;
-}
-
-char Piece::getPsymb() const {
-    return psymb;
-}
+// ------------------------------------------------
+//                    PIECE
+// ------------------------------------------------
 
-Color Piece::getColor() const {
-    return color;
-}
+// icons and symbols indexed by the packed value of the piece
+static const char* icons[16] = {
+    " ", "♙", "♘", "♗", "♖", "♕", "♔", " ",
+    " ", "♟", "♞", "♝", "♜", "♛", "♚", " "
+};
 
-string Piece::getPosition() const {
-    return position;
-}
+static const char symbols[17] = " PNBRQK  PNBRQK ";
 
-bool Piece::getHasMoved() const {
-    return hasMoved;
+const char* Piece::getIcon() const {
+    return icons[data];
 }
 
-void Piece::setPosition(string position) {
-    this->position = position;
+char Piece::getPsymb() const {
+    return symbols[data];
 }
-
-void Piece::setHasMoved() {
-    this->hasMoved = true;
-}
\ No newline at end of file
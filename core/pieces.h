@@ -3,6 +3,10 @@
  * @brief Header file for the game pieces
  */
 
+#ifndef PIECES_H
+#define PIECES_H
+
+#include <cstdint>
 #include <string>
 using namespace std;
 
@@ -16,170 +20,193 @@ enum class Color {
     BLACK
 };
 
+/**
+ * @enum PieceType
+ * @brief Enumerates the types of the pieces, used to index the bitboards
+*/
+enum class PieceType {
+    PAWN,
+    KNIGHT,
+    BISHOP,
+    ROOK,
+    QUEEN,
+    KING
+};
+
+/**
+ * @brief Get the index of a color, used to index the bitboards
+ * @param color The color
+ * @return 0 for white, 1 for black
+*/
+inline int colorIndex(Color color) {
+    return static_cast<int>(color);
+}
+
+/**
+ * @brief Get the index of a piece type, used to index the bitboards
+ * @param type The piece type
+ * @return The index of the piece type (0-5)
+*/
+inline int typeIndex(PieceType type) {
+    return static_cast<int>(type);
+}
+
+/**
+ * @brief Get the opposite color
+ * @param color The color
+ * @return The color of the opponent
+*/
+inline Color opponent(Color color) {
+    return color == Color::WHITE ? Color::BLACK : Color::WHITE;
+}
+
 /**
  * @class Square
- * @brief Class representing a square on the board
+ * @brief Class representing a square on the board, packed in one byte (a1 = 0, h8 = 63)
 */
 class Square {
 private:
-    int column;
-    int line;
+    uint8_t index;
 public:
-    Square(char* move) :
-        column(move[0] - 'a'),
-        line(move[1] - '1')
+    constexpr Square() :
+        index(0)
+    {}
+
+    constexpr explicit Square(int index) :
+        index(uint8_t(index))
+    {}
+
+    constexpr Square(int line, int column) :
+        index(uint8_t(line * 8 + column))
+    {}
+
+    /**
+     * @brief Build a square from its name, the text must start with a valid name ("e4")
+     * @param name The name of the square
+    */
+    constexpr Square(const char* name) :
+        index(uint8_t((name[1] - '1') * 8 + (name[0] - 'a')))
     {}
-    
+
+    // ------------------------------------------------
+    //                    GETTERS
+    // ------------------------------------------------
+
     /**
      * @brief Get the line of the square
      * @return The line of the square
     */
-    int getLine() const;
+    constexpr int getLine() const {
+        return index >> 3;
+    }
 
     /**
      * @brief Get the column of the square
      * @return The column of the square
     */
-    int getColumn() const;
+    constexpr int getColumn() const {
+        return index & 7;
+    }
+
+    /**
+     * @brief Get the index of the square, used to index the bitboards
+     * @return The index of the square (a1 = 0, h8 = 63)
+    */
+    constexpr int getIndex() const {
+        return index;
+    }
 
     /**
-     * @brief Convert the square to a string
-     * @return The string representation of the square
+     * @brief Write the name of the square ("e4") in a buffer, followed by a null character
+     * @param buffer The buffer to fill, at least 3 characters long
+     * @return A pointer to the null character, to append more text
     */
-    string toString() const;
+    char* write(char* buffer) const;
+
+    constexpr bool operator==(const Square & other) const {
+        return index == other.index;
+    }
+
+    constexpr bool operator!=(const Square & other) const {
+        return index != other.index;
+    }
 };
 
 // ------------------------------------------------
-//              PARENT CLASS PIECE
+//                     PIECE
 // ------------------------------------------------
 
 /**
  * @class Piece
- * @brief Class representing a piece on the board
+ * @brief Class representing a piece on the board, packed in one byte (type + 1 in the low bits, color in bit 3, 0 for no piece)
 */
 class Piece {
 private:
-    string name;
-    Color color;
-    char psymb;
-    int id;
-    string position;
-    bool hasMoved = false;
+    uint8_t data;
 public:
-    Piece(string name, Color color, char psymb, int id, string position) :
-        name(name),
-        color(color),
-        psymb(psymb),
-        id(id),
-        position(position)
+    Piece() :
+        data(0)
+    {}
+
+    Piece(Color color, PieceType type) :
+        data(uint8_t(typeIndex(type) + 1 + (colorIndex(color) << 3)))
     {}
 
     // ------------------------------------------------
-    //                 GETTERS & SETTERS
+    //                    GETTERS
     // ------------------------------------------------
 
     /**
-     * @brief Get the icon of the piece
-     * @return The icon of the piece
+     * @brief Check if there is no piece
+     * @return true for an empty square, false otherwise
     */
-    string getIcon() const;
+    bool isEmpty() const {
+        return data == 0;
+    }
 
     /**
-     * @brief Get the piece symbol
-     * @return The piece symbol (Pawn: P, Rook: R, Knight: N, Bishop: B, Queen: Q, King: K)
+     * @brief Get the type of the piece
+     * @return The type of the piece
     */
-    char getPsymb() const;
+    PieceType getType() const {
+        return static_cast<PieceType>((data & 7) - 1);
+    }
 
     /**
      * @brief Get the color of the piece
      * @return The color of the piece
     */
-    Color getColor() const;
+    Color getColor() const {
+        return static_cast<Color>(data >> 3);
+    }
 
     /**
-     * @brief Get the position of the piece
-     * @return The position of the piece
+     * @brief Get the packed value of the piece, used to index tables
+     * @return The packed value (0-14), 0 for no piece
     */
-    string getPosition() const;
+    int getCode() const {
+        return data;
+    }
 
     /**
-     * @brief Get if the piece has moved
-     * @return True if the piece has moved, false otherwise
-    */
-    bool getHasMoved() const;
-
-    /**
-     * @brief Set the position of the piece
-     * @param position The new position of the piece
+     * @brief Get the icon of the piece
+     * @return The icon of the piece
     */
-    void setPosition(string position);
+    const char* getIcon() const;
 
     /**
-     * @brief Set the piece as moved, used for castling and pawn double move
+     * @brief Get the piece symbol
+     * @return The piece symbol (Pawn: P, Rook: R, Knight: N, Bishop: B, Queen: Q, King: K)
     */
-    void setHasMoved();
-};
-
-// ------------------------------------------------
-//                PIECE CLASSES
-// ------------------------------------------------
-
-/**
- * @class Pawn
- * @brief Class representing a pawn piece
-*/
-class Pawn : public Piece {
-public:
-    Pawn(Color color, int id, string position) :
-        Piece((color == Color::WHITE ? "♙" : "♟"), color, 'P', id, position) {}
-};
-
-/**
- * @class Rook
- * @brief Class representing a rook piece
-*/
-class Rook : public Piece {
-public:
-    Rook(Color color, int id, string position) :
-        Piece((color == Color::WHITE ? "♖" : "♜"), color, 'R', id, position) {}
-};
-
-/**
- * @class Knight
- * @brief Class representing a knight piece
-*/
-class Knight : public Piece {
-public:
-    Knight(Color color, int id, string position) :
-        Piece((color == Color::WHITE ? "♘" : "♞"), color, 'N', id, position) {}
-};
+    char getPsymb() const;
 
-/**
- * @class Bishop
- * @brief Class representing a bishop piece
-*/
-class Bishop : public Piece {
-public:
-    Bishop(Color color, int id, string position) :
-        Piece((color == Color::WHITE ? "♗" : "♝"), color, 'B', id, position) {}
-};
+    bool operator==(const Piece & other) const {
+        return data == other.data;
+    }
 
-/**
- * @class Queen
- * @brief Class representing a queen piece
-*/
-class Queen : public Piece {
-public:
-    Queen(Color color, int id, string position) :
-        Piece((color == Color::WHITE ? "♕" : "♛"), color, 'Q', id, position) {}
+    bool operator!=(const Piece & other) const {
+        return data != other.data;
+    }
 };
 
-/**
- * @class King
- * @brief Class representing a king piece
-*/
-class King : public Piece {
-public:
-    King(Color color, int id, string position) :
-        Piece((color == Color::WHITE ? "♔" : "♚"), color, 'K', id, position) {}
-};
\ No newline at end of file
+#endif
@@ -0,0 +1,89 @@
+/**
+ * @file position.cpp
+ * @brief Implementation file for the bitboard representation of the position
+ */
+
+#include "position.h"
+
+// ------------------------------------------------
+//               PIECES PLACEMENT
+// ------------------------------------------------
+
+void Position::clear() {
+    for (int color = 0; color < 2; color++) {
+        for (int type = 0; type < 6; type++) {
+            pieces[color][type] = 0;
+        }
+        colorOccupancy[color] = 0;
+    }
+    occupancy = 0;
+}
+
+// ------------------------------------------------
+//                    GETTERS
+// ------------------------------------------------
+
+bool Position::findPiece(Color color, int square, PieceType & type) const {
+    Bitboard bit = squareBit(square);
+    if (!(colorOccupancy[colorIndex(color)] & bit)) {
+        return false;
+    }
+
+    for (int t = 0; t < 6; t++) {
+        if (pieces[colorIndex(color)][t] & bit) {
+            type = static_cast<PieceType>(t);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Bitboard Position::attackersTo(int square, Bitboard occupancy) const {
+    const Bitboard* white = pieces[colorIndex(Color::WHITE)];
+    const Bitboard* black = pieces[colorIndex(Color::BLACK)];
+    Bitboard diagonals =
+        white[typeIndex(PieceType::BISHOP)] | white[typeIndex(PieceType::QUEEN)] |
+        black[typeIndex(PieceType::BISHOP)] | black[typeIndex(PieceType::QUEEN)];
+    Bitboard lines =
+        white[typeIndex(PieceType::ROOK)] | white[typeIndex(PieceType::QUEEN)] |
+        black[typeIndex(PieceType::ROOK)] | black[typeIndex(PieceType::QUEEN)];
+
+    return
+        (pawnAttacks(Color::BLACK, square) & white[typeIndex(PieceType::PAWN)]) |
+        (pawnAttacks(Color::WHITE, square) & black[typeIndex(PieceType::PAWN)]) |
+        (knightAttacks(square) & (white[typeIndex(PieceType::KNIGHT)] | black[typeIndex(PieceType::KNIGHT)])) |
+        (kingAttacks(square) & (white[typeIndex(PieceType::KING)] | black[typeIndex(PieceType::KING)])) |
+        (bishopAttacks(square, occupancy) & diagonals) |
+        (rookAttacks(square, occupancy) & lines);
+}
+
+bool Position::isSquareAttacked(int square, Color byColor) const {
+    const Bitboard* attackers = pieces[colorIndex(byColor)];
+    Bitboard diagonals = attackers[typeIndex(PieceType::BISHOP)] | attackers[typeIndex(PieceType::QUEEN)];
+    Bitboard lines = attackers[typeIndex(PieceType::ROOK)] | attackers[typeIndex(PieceType::QUEEN)];
+
+    // look from the square with each kind of piece: it is attacked if it sees one of them
+    return
+        (pawnAttacks(opponent(byColor), square) & attackers[typeIndex(PieceType::PAWN)]) ||
+        (knightAttacks(square) & attackers[typeIndex(PieceType::KNIGHT)]) ||
+        (kingAttacks(square) & attackers[typeIndex(PieceType::KING)]) ||
+        (bishopAttacks(square, occupancy) & diagonals) ||
+        (rookAttacks(square, occupancy) & lines);
+}
+
+void Position::fillSymbols(const char* symbols[64]) const {
+    static const char* names[2][6] = {
+        {"wP", "wN", "wB", "wR", "wQ", "wK"},
+        {"bP", "bN", "bB", "bR", "bQ", "bK"}
+    };
+
+    for (int color = 0; color < 2; color++) {
+        for (int type = 0; type < 6; type++) {
+            Bitboard bitboard = pieces[color][type];
+            while (bitboard) {
+                symbols[popLsb(bitboard)] = names[color][type];
+            }
+        }
+    }
+}
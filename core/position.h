@@ -0,0 +1,157 @@
+/**
+ * @file position.h
+ * @brief Header file for the bitboard representation of the position
+ */
+
+#ifndef POSITION_H
+#define POSITION_H
+
+#include "bitboard.h"
+#include "attacks.h"
+#include "pieces.h"
+
+using namespace std;
+
+/**
+ * @enum CastlingRight
+ * @brief Flags of the castling rights, combined in an int
+*/
+enum CastlingRight {
+    WHITE_KINGSIDE = 1,
+    WHITE_QUEENSIDE = 2,
+    BLACK_KINGSIDE = 4,
+    BLACK_QUEENSIDE = 8
+};
+
+/**
+ * @class Position
+ * @brief Class storing the pieces as one bitboard per color and piece type, plus occupancy masks
+*/
+class Position {
+private:
+    Bitboard pieces[2][6];
+    Bitboard colorOccupancy[2];
+    Bitboard occupancy;
+public:
+    Position() {
+        clear();
+    }
+
+    /**
+     * @brief Remove every piece from the position
+    */
+    void clear();
+
+    /**
+     * @brief Add a piece on an empty square
+     * @param color The color of the piece
+     * @param type The type of the piece
+     * @param square The index of the square
+    */
+    void addPiece(Color color, PieceType type, int square) {
+        Bitboard bit = squareBit(square);
+        pieces[colorIndex(color)][typeIndex(type)] |= bit;
+        colorOccupancy[colorIndex(color)] |= bit;
+        occupancy |= bit;
+    }
+
+    /**
+     * @brief Remove a piece from its square
+     * @param color The color of the piece
+     * @param type The type of the piece
+     * @param square The index of the square
+    */
+    void removePiece(Color color, PieceType type, int square) {
+        Bitboard bit = squareBit(square);
+        pieces[colorIndex(color)][typeIndex(type)] &= ~bit;
+        colorOccupancy[colorIndex(color)] &= ~bit;
+        occupancy &= ~bit;
+    }
+
+    /**
+     * @brief Move a piece to an empty square
+     * @param color The color of the piece
+     * @param type The type of the piece
+     * @param from The index of the start square
+     * @param to The index of the end square
+    */
+    void movePiece(Color color, PieceType type, int from, int to) {
+        Bitboard bits = squareBit(from) | squareBit(to);
+        pieces[colorIndex(color)][typeIndex(type)] ^= bits;
+        colorOccupancy[colorIndex(color)] ^= bits;
+        occupancy ^= bits;
+    }
+
+    // ------------------------------------------------
+    //                    GETTERS
+    // ------------------------------------------------
+
+    /**
+     * @brief Get the squares of the pieces of a color and a type
+     * @param color The color of the pieces
+     * @param type The type of the pieces
+     * @return The bitboard of the pieces
+    */
+    Bitboard getPieces(Color color, PieceType type) const {
+        return pieces[colorIndex(color)][typeIndex(type)];
+    }
+
+    /**
+     * @brief Get the squares occupied by the pieces of a color
+     * @param color The color of the pieces
+     * @return The occupancy bitboard of the color
+    */
+    Bitboard getColorOccupancy(Color color) const {
+        return colorOccupancy[colorIndex(color)];
+    }
+
+    /**
+     * @brief Get the squares occupied by any piece
+     * @return The occupancy bitboard
+    */
+    Bitboard getOccupancy() const {
+        return occupancy;
+    }
+
+    /**
+     * @brief Check if a square is occupied
+     * @param square The index of the square
+     * @return true if a piece is on the square, false otherwise
+    */
+    bool isOccupied(int square) const {
+        return occupancy & squareBit(square);
+    }
+
+    /**
+     * @brief Find the type of the piece of a color standing on a square
+     * @param color The color of the piece
+     * @param square The index of the square
+     * @param type The type of the piece, set if one is found
+     * @return true if a piece of this color is on the square, false otherwise
+    */
+    bool findPiece(Color color, int square, PieceType & type) const;
+
+    /**
+     * @brief Get the pieces of both colors attacking a square
+     * @param square The index of the square
+     * @param occupancy The occupancy used to stop the sliding pieces
+     * @return The squares of the attacking pieces
+    */
+    Bitboard attackersTo(int square, Bitboard occupancy) const;
+
+    /**
+     * @brief Check if a square is attacked by the pieces of a color
+     * @param square The index of the square
+     * @param byColor The color of the attacking pieces
+     * @return true if at least one piece of this color attacks the square, false otherwise
+    */
+    bool isSquareAttacked(int square, Color byColor) const;
+
+    /**
+     * @brief Fill a 64 squares table with the symbols of the pieces ("wP", "bK", ...)
+     * @param symbols The table to fill, empty squares are left untouched
+    */
+    void fillSymbols(const char* symbols[64]) const;
+};
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * @file replay.cpp
+ * @brief Implementation file for the replay of the move transcripts
+ */
+
+#include "replay.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+/**
+ * @brief Append the games of a transcript file to the commands
+ * @param path The path of the file
+ * @param commands The commands, one per line
+ * @return true if the file is read, false otherwise
+*/
+static bool appendTranscript(const string & path, string & commands) {
+    ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    // the commands after the last "/quit" are dropped when the file ends
+    size_t gamesEnd = commands.size();
+    bool hasQuit = false;
+
+    string line;
+    while (getline(file, line)) {
+        if (line.find('#') != string::npos) {
+            continue;
+        }
+
+        istringstream tokens(line);
+        string token;
+        while (tokens >> token) {
+            commands += token;
+            commands += '\n';
+            if (token == "/quit") {
+                gamesEnd = commands.size();
+                hasQuit = true;
+            }
+        }
+    }
+
+    if (hasQuit) {
+        commands.resize(gamesEnd);
+    } else {
+        commands += "/quit\n";
+    }
+    return true;
+}
+
+bool loadTranscripts(const string & path, string & commands) {
+    error_code error;
+    if (!filesystem::is_directory(path, error)) {
+        return appendTranscript(path, commands);
+    }
+
+    // the hidden files are left out, like the "._" metadata files written by macOS next to the transcripts
+    vector<string> files;
+    for (const filesystem::directory_entry & entry : filesystem::directory_iterator(path, error)) {
+        string name = entry.path().filename().string();
+        if (entry.is_regular_file(error) && entry.path().extension() == ".txt" && name[0] != '.') {
+            files.push_back(entry.path().string());
+        }
+    }
+    sort(files.begin(), files.end());
+
+    for (const string & file : files) {
+        if (!appendTranscript(file, commands)) {
+            return false;
+        }
+    }
+    return !error;
+}
+
+string replayGame(Board & board, istream & commands) {
+    // a stream without buffer drops everything written in it
+    ostream silent(nullptr);
+    board.setStreams(commands, silent, false);
+    board.initGame();
+
+    // a game ended by a checkmate, a stalemate, a resignation or a draw leaves the commands typed after it
+    if (board.isGameOver()) {
+        string command;
+        while (commands >> command && command != "/quit") {
+        }
+    }
+
+    board.setStreams(cin, cout, true);
+    return board.canonical_position();
+}
+
+long replayTranscripts(const string & path, ostream & output) {
+    string commands;
+    if (!loadTranscripts(path, commands)) {
+        return -1;
+    }
+
+    Board board;
+    istringstream stream(commands);
+    long games = 0;
+    while (stream >> ws && stream.peek() != EOF) {
+        output << replayGame(board, stream) << '\n';
+        games++;
+    }
+
+    output.flush();
+    return games;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file replay.h
+ * @brief Header file for the replay of the move transcripts, checking many games in one process
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <iostream>
+#include <string>
+
+#include "board.h"
+
+using namespace std;
+
+/**
+ * @brief Read the transcripts of a file, or of all the .txt files of a directory (hidden files aside) in the order of their names
+ *
+ * A transcript holds the commands typed by the players, as in tests/data: the lines with a '#' are comments
+ * and a game ends with "/quit". A file may hold several games, what follows its last "/quit" is ignored (the
+ * expected result of the test transcripts), and a file without "/quit" is one game.
+ * @param path The path of the file or of the directory
+ * @param commands Filled with the commands of all the games, each one ended by "/quit"
+ * @return true if the transcripts are read, false if the path can't be read
+*/
+bool loadTranscripts(const string & path, string & commands);
+
+/**
+ * @brief Play a game from its commands without drawing or writing anything, as the game loop would
+ * @param board The board, reset to the starting position
+ * @param commands The stream of the commands, read until the "/quit" ending the game or its end
+ * @return The canonical position of the end of the game with its result
+*/
+string replayGame(Board & board, istream & commands);
+
+/**
+ * @brief Replay all the games of a file or of a directory with one board, writing one result line for each game
+ * @param path The path of the file or of the directory of the transcripts (.txt files)
+ * @param output The stream of the canonical positions of the games
+ * @return The number of games, -1 if the path can't be read
+*/
+long replayTranscripts(const string & path, ostream & output);
+
+#endif
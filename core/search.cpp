@@ -0,0 +1,438 @@
+/**
+ * @file search.cpp
+ * @brief Implementation file for the alpha-beta search playing the moves of the computer
+ */
+
+#include "search.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "board.h"
+#include "evaluate.h"
+#include "ordering.h"
+#include "timeman.h"
+
+/**
+ * @struct SharedSearch
+ * @brief State shared by the threads of a search
+*/
+struct SharedSearch {
+    SearchLimits limits;
+    TranspositionTable* table;
+    TimeManager time;
+    atomic<bool> stopped;                       ///< set by the main thread to stop every thread
+    vector<const atomic<uint64_t>*> nodeCounts; ///< node counter of each thread
+
+    SharedSearch(const SearchLimits & limits, TranspositionTable * table, Color side) :
+        limits(limits),
+        table(table),
+        time(limits, side),
+        stopped(false)
+    {}
+};
+
+/**
+ * @struct SearchContext
+ * @brief State of one search thread, searching on its own copy of the board
+*/
+struct SearchContext {
+    SharedSearch & shared;
+    Board board;
+    int id;                         ///< 0 for the main thread, which checks the limits and gives the result
+    atomic<uint64_t> nodes;         ///< only written by the thread, read by the main thread
+    bool canStop = false;           ///< false until the first iteration is completed, the node and time limits being ignored until then
+
+    Move pv[MAX_PLY][MAX_PLY];      ///< principal variation found from each ply
+    int pvLength[MAX_PLY];          ///< number of moves of the principal variation of each ply
+    Move rootBest;                  ///< best move of the previous iteration, searched first
+    OrderingTables ordering;        ///< killer, history and counter moves learnt by the thread
+    PawnTable & pawns;              ///< pawn structures analyzed by the thread, kept between the searches
+
+    SearchContext(SharedSearch & shared, const Board & board, int id, PawnTable & pawns) :
+        shared(shared),
+        board(board),
+        id(id),
+        nodes(0),
+        pawns(pawns)
+    {}
+};
+
+/**
+ * @brief Get the time spent since the start of the search
+ * @return The time in milliseconds
+*/
+static int64_t elapsed(const SharedSearch & shared) {
+    return shared.time.elapsed();
+}
+
+/**
+ * @brief Get the number of nodes searched by all the threads
+ * @return The number of nodes
+*/
+static uint64_t totalNodes(const SharedSearch & shared) {
+    uint64_t total = 0;
+    for (const atomic<uint64_t>* count : shared.nodeCounts) {
+        total += count->load(memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * @brief Check the node and time limits and the stop request from the main thread, only every TIME_CHECK_NODES nodes
+ *
+ * The stop request is honored from the start of the search, the node and time limits only once the first iteration
+ * is completed so that a limited search always has a searched best move.
+*/
+static void checkLimits(SearchContext & context) {
+    SharedSearch & shared = context.shared;
+    if (context.id != 0 || context.nodes.load(memory_order_relaxed) % TIME_CHECK_NODES != 0) {
+        return;
+    }
+
+    if (
+        (shared.limits.stopRequest && shared.limits.stopRequest->load(memory_order_relaxed)) ||
+        (context.canStop && shared.limits.maxNodes && totalNodes(shared) >= shared.limits.maxNodes) ||
+        (context.canStop && shared.time.isOutOfTime())
+    ) {
+        shared.stopped.store(true, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Check if the search is stopped
+ * @return true if the threads must stop searching, false otherwise
+*/
+static bool isStopped(const SearchContext & context) {
+    return context.shared.stopped.load(memory_order_relaxed);
+}
+
+// ------------------------------------------------
+//                  ALPHA-BETA
+// ------------------------------------------------
+
+/**
+ * @brief Convert a score to save it in the transposition table, the mates being counted from the position
+ * @param score The score, mates counted from the root
+ * @param ply The distance to the root
+ * @return The score to save
+*/
+static int scoreToTable(int score, int ply) {
+    if (score > MATE_SCORE - MAX_PLY) {
+        return score + ply;
+    }
+    if (score < -MATE_SCORE + MAX_PLY) {
+        return score - ply;
+    }
+    return score;
+}
+
+/**
+ * @brief Convert a score read from the transposition table, the mates being counted from the root
+ * @param score The saved score, mates counted from the position
+ * @param ply The distance to the root
+ * @return The score
+*/
+static int scoreFromTable(int score, int ply) {
+    if (score > MATE_SCORE - MAX_PLY) {
+        return score - ply;
+    }
+    if (score < -MATE_SCORE + MAX_PLY) {
+        return score + ply;
+    }
+    return score;
+}
+
+/**
+ * @brief Search only the captures and promotions at the end of the main search, until the position is quiet, so
+ * that a position is never evaluated in the middle of an exchange
+ * @param context The state of the thread
+ * @param ply The distance to the root
+ * @param alpha The score the player to move is already sure to get
+ * @param beta The score the opponent is already sure to get
+ * @return The score of the position for the player to move, 0 if the search is stopped
+*/
+static int quiescence(SearchContext & context, int ply, int alpha, int beta) {
+    Board & board = context.board;
+    context.pvLength[ply] = 0;
+    context.nodes.store(context.nodes.load(memory_order_relaxed) + 1, memory_order_relaxed);
+
+    checkLimits(context);
+    if (isStopped(context)) {
+        return 0;
+    }
+
+    MovePicker picker(board, context.ordering, Move(), ply);
+    bool inCheck = board.isCheck(board.getSideToMove() == Color::WHITE);
+    if (picker.size() == 0) {
+        return inCheck ? -MATE_SCORE + ply : 0;
+    }
+
+    if (ply >= MAX_PLY - 1) {
+        return evaluate(board, &context.pawns);
+    }
+
+    // the player may stand on the evaluation instead of capturing, unless in check where every evasion is searched
+    int best = -MATE_SCORE;
+    if (!inCheck) {
+        best = evaluate(board, &context.pawns);
+        if (best >= beta) {
+            return best;
+        }
+        alpha = max(alpha, best);
+    }
+
+    Move move;
+    while (picker.next(move)) {
+        // the good captures come first: the moves after the first quiet or losing one are not searched
+        if (!inCheck && (!isTactical(board, move) || losesExchange(board, move))) {
+            break;
+        }
+
+        board.makeMove(move);
+        int score = -quiescence(context, ply + 1, -beta, -alpha);
+        board.unmakeMove();
+
+        if (isStopped(context)) {
+            return 0;
+        }
+
+        if (score > best) {
+            best = score;
+        }
+
+        if (score > alpha) {
+            alpha = score;
+
+            context.pv[ply][0] = move;
+            for (int i = 0; i < context.pvLength[ply + 1]; i++) {
+                context.pv[ply][i + 1] = context.pv[ply + 1][i];
+            }
+            context.pvLength[ply] = context.pvLength[ply + 1] + 1;
+
+            if (alpha >= beta) {
+                break;
+            }
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Search a position with the negamax alpha-beta algorithm
+ * @param context The state of the thread
+ * @param depth The remaining depth
+ * @param ply The distance to the root
+ * @param alpha The score the player to move is already sure to get
+ * @param beta The score the opponent is already sure to get
+ * @return The score of the position for the player to move, 0 if the search is stopped
+*/
+static int negamax(SearchContext & context, int depth, int ply, int alpha, int beta) {
+    Board & board = context.board;
+    TranspositionTable* table = context.shared.table;
+    context.pvLength[ply] = 0;
+    context.nodes.store(context.nodes.load(memory_order_relaxed) + 1, memory_order_relaxed);
+
+    checkLimits(context);
+    if (isStopped(context)) {
+        return 0;
+    }
+
+    // a repeated position or 50 moves without capture nor pawn move is a draw
+    if (ply > 0 && (board.isRepetition(2) || board.getHalfmoveClock() >= 100)) {
+        return 0;
+    }
+
+    // a result saved by a search at least as deep can give the score without searching
+    TableEntry saved;
+    Move tableMove;
+    if (table && table->probe(board.getHashKey(), saved)) {
+        tableMove = saved.move;
+        int score = scoreFromTable(saved.score, ply);
+        if (
+            ply > 0 && saved.depth >= depth && (
+                saved.bound == Bound::EXACT ||
+                (saved.bound == Bound::LOWER && score >= beta) ||
+                (saved.bound == Bound::UPPER && score <= alpha)
+            )
+        ) {
+            return score;
+        }
+    }
+
+    if (depth == 0 || ply >= MAX_PLY - 1) {
+        return quiescence(context, ply, alpha, beta);
+    }
+
+    // the best move of the previous iteration or of the table is searched first, to get a good alpha early
+    MovePicker picker(board, context.ordering, ply == 0 && context.rootBest != Move() ? context.rootBest : tableMove, ply);
+    if (picker.size() == 0) {
+        return board.isCheck(board.getSideToMove() == Color::WHITE) ? -MATE_SCORE + ply : 0;
+    }
+
+    int originalAlpha = alpha;
+    int best = -MATE_SCORE;
+    Move bestMove;
+    Move quietsTried[256];
+    int quietCount = 0;
+
+    Move move;
+    while (picker.next(move)) {
+        bool quiet = !isTactical(board, move);
+
+        board.makeMove(move);
+        int score = -negamax(context, depth - 1, ply + 1, -beta, -alpha);
+        board.unmakeMove();
+
+        if (isStopped(context)) {
+            return 0;
+        }
+
+        if (score > best) {
+            best = score;
+            bestMove = move;
+        }
+
+        if (score > alpha) {
+            alpha = score;
+
+            // the principal variation is this move followed by the one of the child
+            context.pv[ply][0] = move;
+            for (int i = 0; i < context.pvLength[ply + 1]; i++) {
+                context.pv[ply][i + 1] = context.pv[ply + 1][i];
+            }
+            context.pvLength[ply] = context.pvLength[ply + 1] + 1;
+
+            if (alpha >= beta) {
+                if (quiet) {
+                    context.ordering.updateQuietCutoff(board, move, quietsTried, quietCount, depth, ply);
+                }
+                break;
+            }
+        }
+
+        if (quiet) {
+            quietsTried[quietCount++] = move;
+        }
+    }
+
+    if (table) {
+        Bound bound = best >= beta ? Bound::LOWER : best > originalAlpha ? Bound::EXACT : Bound::UPPER;
+        table->store(board.getHashKey(), {bestMove, scoreToTable(best, ply), depth, bound});
+    }
+
+    return best;
+}
+
+// ------------------------------------------------
+//               ITERATIVE DEEPENING
+// ------------------------------------------------
+
+// helper threads skip some depths, so that they don't all search the same tree as the main thread
+static const int skipSize[20] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+static const int skipPhase[20] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+/**
+ * @brief Search deeper and deeper with a helper thread, until the main thread stops the search
+ * @param context The state of the thread
+ * @param maxDepth The deepest iteration
+*/
+static void helperSearch(SearchContext & context, int maxDepth) {
+    int pattern = (context.id - 1) % 20;
+
+    for (int depth = 1; depth <= maxDepth && !isStopped(context); depth++) {
+        if (((depth + skipPhase[pattern]) / skipSize[pattern]) % 2 != 0) {
+            continue;
+        }
+
+        negamax(context, depth, 0, -MATE_SCORE, MATE_SCORE);
+        if (!isStopped(context) && context.pvLength[0] > 0) {
+            context.rootBest = context.pv[0][0];
+        }
+    }
+}
+
+SearchResult searchBestMove(Board & board, const SearchLimits & limits, TranspositionTable * table, vector<PawnTable> * pawnTables, const function<void(const SearchResult &)> & onIteration) {
+    SharedSearch shared(limits, table, board.getSideToMove());
+    SearchResult result;
+
+    if (table) {
+        table->newSearch();
+    }
+
+    int maxDepth = limits.maxDepth > 0 && limits.maxDepth < MAX_PLY ? limits.maxDepth : MAX_PLY - 1;
+
+    // every thread searches its own copy of the board, only the table is shared (Lazy SMP)
+    int threads = max(1, limits.threads);
+    vector<PawnTable> searchPawnTables;
+    if (!pawnTables) {
+        pawnTables = &searchPawnTables;
+    }
+    if (pawnTables->size() < size_t(threads)) {
+        pawnTables->resize(threads);
+    }
+
+    vector<unique_ptr<SearchContext>> contexts;
+    for (int id = 0; id < threads; id++) {
+        contexts.push_back(make_unique<SearchContext>(shared, board, id, (*pawnTables)[id]));
+        shared.nodeCounts.push_back(&contexts.back()->nodes);
+    }
+
+    vector<thread> helpers;
+    for (int id = 1; id < threads; id++) {
+        helpers.emplace_back(helperSearch, ref(*contexts[id]), maxDepth);
+    }
+
+    SearchContext & context = *contexts[0];
+    int stableIterations = 0;
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        int score = negamax(context, depth, 0, -MATE_SCORE, MATE_SCORE);
+        if (isStopped(context) || context.pvLength[0] == 0) {
+            break;
+        }
+
+        stableIterations = context.pv[0][0] == result.bestMove ? stableIterations + 1 : 0;
+        result.bestMove = context.pv[0][0];
+        result.score = score;
+        result.depth = depth;
+        result.nodes = totalNodes(shared);
+        result.time = elapsed(shared);
+        result.pv.assign(context.pv[0], context.pv[0] + context.pvLength[0]);
+        context.rootBest = result.bestMove;
+        context.canStop = true;
+
+        if (onIteration) {
+            onIteration(result);
+        }
+
+        // no need to look deeper once a mate is found, or if the time manager gives no time for another iteration
+        if (isMateScore(score) || shared.time.shouldStop(stableIterations)) {
+            break;
+        }
+    }
+
+    // the helpers stop at the next node they search
+    shared.stopped.store(true, memory_order_relaxed);
+    for (thread & helper : helpers) {
+        helper.join();
+    }
+
+    // stopped during the first iteration: the best of the root moves already searched, else the first legal move
+    if (result.bestMove == Move() && context.pvLength[0] > 0) {
+        result.bestMove = context.pv[0][0];
+        result.pv.assign(context.pv[0], context.pv[0] + context.pvLength[0]);
+    } else if (result.bestMove == Move()) {
+        MoveList moves;
+        board.generateLegalMoves(moves);
+        if (!moves.empty()) {
+            result.bestMove = moves[0];
+            result.pv.assign(1, moves[0]);
+        }
+    }
+
+    result.nodes = totalNodes(shared);
+    result.time = elapsed(shared);
+    return result;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file search.h
+ * @brief Header file for the alpha-beta search playing the moves of the computer
+ */
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "move.h"
+#include "transposition.h"
+
+using namespace std;
+
+class Board;
+class PawnTable;
+
+/**
+ * @brief Score of a checkmate at the root, the mates found deeper are worth a bit less
+*/
+const int MATE_SCORE = 32000;
+
+/**
+ * @brief Deepest ply the search can reach
+*/
+const int MAX_PLY = 128;
+
+/**
+ * @struct SearchLimits
+ * @brief Limits of a search, the search stops at the first one reached (0 for no limit)
+ *
+ * The time of the search is managed by a TimeManager from the fixed time and the clock of the player to move.
+*/
+struct SearchLimits {
+    int maxDepth = 0;               ///< deepest iteration
+    uint64_t maxNodes = 0;          ///< number of nodes
+    int64_t maxTime = 0;            ///< time in milliseconds
+    int64_t clockTime[2] = {0, 0};  ///< time left on the clock of White and Black in milliseconds, 0 if the game is not timed
+    int64_t increment[2] = {0, 0};  ///< time added to the clock of White and Black after each move, in milliseconds
+    int movesToGo = 0;              ///< moves to play before the next time control, 0 if the clock is for the rest of the game
+    int threads = 1;                ///< number of threads searching together, sharing the transposition table
+    const atomic<bool>* stopRequest = nullptr;  ///< set by another thread to stop the search, may be empty
+};
+
+/**
+ * @struct SearchResult
+ * @brief Result of the last completed iteration of a search
+*/
+struct SearchResult {
+    Move bestMove;          ///< first move of the principal variation
+    int score = 0;          ///< score in centipawns for the player to move
+    int depth = 0;          ///< depth of the iteration
+    uint64_t nodes = 0;     ///< nodes searched by all the threads since the start of the search
+    int64_t time = 0;       ///< time spent since the start of the search, in milliseconds
+    vector<Move> pv;        ///< principal variation, the moves expected from both players
+};
+
+/**
+ * @brief Find the best move of the player to move with an iterative deepening negamax alpha-beta search
+ *
+ * With several threads, the helper threads search the same position on their own copy of the board (Lazy SMP),
+ * skipping some depths, and share what they find through the transposition table. The result is the one of the
+ * main thread.
+ * @param board The board, left unchanged
+ * @param limits The limits of the search, the first iteration always being completed within the node and time
+ * limits, while the stop request can end it before
+ * @param table The transposition table to reuse the results of the positions already searched, nullptr for none
+ * @param pawnTables The pawn tables kept between the searches, one for each thread (the list grows to the number
+ * of threads), nullptr to use tables dropped at the end of the search
+ * @param onIteration Function called with the result of each completed iteration, may be empty
+ * @return The result of the last completed iteration, with the best root move searched so far (or the first legal
+ * move) if none was completed, and without move if the player has no legal move
+*/
+SearchResult searchBestMove(Board & board, const SearchLimits & limits, TranspositionTable * table = nullptr, vector<PawnTable> * pawnTables = nullptr, const function<void(const SearchResult &)> & onIteration = nullptr);
+
+/**
+ * @brief Check if a score is a checkmate score
+ * @param score The score
+ * @return true if the score announces a checkmate, false otherwise
+*/
+inline bool isMateScore(int score) {
+    return score > MATE_SCORE - MAX_PLY || score < -MATE_SCORE + MAX_PLY;
+}
+
+#endif
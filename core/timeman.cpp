@@ -0,0 +1,58 @@
+/**
+ * @file timeman.cpp
+ * @brief Implementation file for the time management of the search
+ */
+
+#include "timeman.h"
+
+#include <algorithm>
+
+#include "search.h"
+
+// share of the optimum time given to the next iterations by the number of iterations in a row with the same best move
+static const int STABILITY_PERCENTS[5] = {160, 120, 100, 80, 65};
+
+TimeManager::TimeManager(const SearchLimits & limits, Color side) :
+    start(chrono::steady_clock::now())
+{
+    int64_t clock = limits.clockTime[colorIndex(side)];
+    int64_t increment = limits.increment[colorIndex(side)];
+
+    if (clock > 0) {
+        // the time is shared between the moves left before the time control, or an estimate of the moves left in the game
+        int movesLeft = limits.movesToGo > 0 ? min(limits.movesToGo, 50) : 30;
+        int64_t available = max<int64_t>(1, clock - MOVE_OVERHEAD);
+
+        usesClock = true;
+        maximumTime = max<int64_t>(1, min(available * 4 / 5, (available / movesLeft + increment) * 4));
+        optimumTime = max<int64_t>(1, min(maximumTime, available / movesLeft + increment * 3 / 4));
+    }
+
+    // a fixed time per move is the budget, or caps the budget of the clock
+    if (limits.maxTime > 0) {
+        optimumTime = optimumTime ? min(optimumTime, limits.maxTime) : limits.maxTime;
+        maximumTime = maximumTime ? min(maximumTime, limits.maxTime) : limits.maxTime;
+    }
+}
+
+int64_t TimeManager::elapsed() const {
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+}
+
+bool TimeManager::isOutOfTime() const {
+    return maximumTime && elapsed() >= maximumTime;
+}
+
+bool TimeManager::shouldStop(int stableIterations) const {
+    if (!optimumTime) {
+        return false;
+    }
+
+    int64_t target = optimumTime;
+    if (usesClock) {
+        target = min(maximumTime, optimumTime * STABILITY_PERCENTS[min(stableIterations, 4)] / 100);
+    }
+
+    // the next iteration takes about as long as all the previous ones
+    return elapsed() * 2 >= target;
+}
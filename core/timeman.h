@@ -0,0 +1,70 @@
+/**
+ * @file timeman.h
+ * @brief Header file for the time management of the search
+ */
+
+#ifndef TIMEMAN_H
+#define TIMEMAN_H
+
+#include <chrono>
+#include <cstdint>
+
+#include "pieces.h"
+
+using namespace std;
+
+struct SearchLimits;
+
+/**
+ * @brief Number of nodes searched between two readings of the clock
+*/
+const int TIME_CHECK_NODES = 1024;
+
+/**
+ * @brief Time kept on the clock for the delays outside the search (reading the position, sending the move), in milliseconds
+*/
+const int64_t MOVE_OVERHEAD = 10;
+
+/**
+ * @class TimeManager
+ * @brief Time budget of a search, from a fixed time per move or from the clock of the player
+ *
+ * The search stops at the maximum time whatever happens. Between two iterations, it stops if the time spent
+ * reaches the optimum time, lengthened while the best move keeps changing and shortened once it is stable,
+ * or if the next iteration can't be completed in it.
+*/
+class TimeManager {
+private:
+    chrono::steady_clock::time_point start;
+    int64_t optimumTime = 0;    ///< time the search should take, 0 for no time limit
+    int64_t maximumTime = 0;    ///< time the search can't exceed, 0 for no time limit
+    bool usesClock = false;     ///< true if the budget comes from the clock, the optimum time then depends on the stability
+public:
+    /**
+     * @brief Start the clock of a search and compute its budget
+     * @param limits The limits of the search
+     * @param side The color of the player to move
+    */
+    TimeManager(const SearchLimits & limits, Color side);
+
+    /**
+     * @brief Get the time spent since the start of the search
+     * @return The time in milliseconds
+    */
+    int64_t elapsed() const;
+
+    /**
+     * @brief Check if the search must stop now, in the middle of an iteration
+     * @return true if the maximum time is reached, false otherwise
+    */
+    bool isOutOfTime() const;
+
+    /**
+     * @brief Check if the search should not start another iteration
+     * @param stableIterations The number of iterations in a row that kept the same best move
+     * @return true if the search should stop, false otherwise
+    */
+    bool shouldStop(int stableIterations) const;
+};
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * @file transposition.cpp
+ * @brief Implementation file for the transposition table shared by the searches
+ */
+
+#include "transposition.h"
+
+// layout of the packed data: move (16 bits), score (16), depth (8), bound (2), generation (6)
+static uint64_t pack(const TableEntry & entry, uint8_t generation) {
+    return
+        uint64_t(entry.move.getData()) |
+        uint64_t(uint16_t(int16_t(entry.score))) << 16 |
+        uint64_t(uint8_t(entry.depth)) << 32 |
+        uint64_t(entry.bound) << 40 |
+        uint64_t(generation & 63) << 42;
+}
+
+static TableEntry unpack(uint64_t data) {
+    TableEntry entry;
+    entry.move = Move::fromData(uint16_t(data));
+    entry.score = int16_t(uint16_t(data >> 16));
+    entry.depth = uint8_t(data >> 32);
+    entry.bound = static_cast<Bound>((data >> 40) & 3);
+    return entry;
+}
+
+static int depthOf(uint64_t data) {
+    return uint8_t(data >> 32);
+}
+
+static uint8_t generationOf(uint64_t data) {
+    return (data >> 42) & 63;
+}
+
+// ------------------------------------------------
+//                  ALLOCATION
+// ------------------------------------------------
+
+TranspositionTable::TranspositionTable(size_t megabytes) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    size_t size = 1;
+    while (size * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024) {
+        size *= 2;
+    }
+
+    buckets = make_unique<Bucket[]>(size);
+    mask = size - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= mask; i++) {
+        for (Slot & slot : buckets[i].slots) {
+            slot.check.store(0, memory_order_relaxed);
+            slot.data.store(0, memory_order_relaxed);
+        }
+    }
+    generation = 0;
+}
+
+void TranspositionTable::newSearch() {
+    generation = (generation + 1) & 63;
+}
+
+TranspositionTable::Bucket & TranspositionTable::bucketOf(HashKey key) const {
+    // the low bits choose the bucket, the whole key is checked in the slot
+    return buckets[key & mask];
+}
+
+// ------------------------------------------------
+//                 PROBE & STORE
+// ------------------------------------------------
+
+bool TranspositionTable::probe(HashKey key, TableEntry & entry) const {
+    for (const Slot & slot : bucketOf(key).slots) {
+        uint64_t data = slot.data.load(memory_order_relaxed);
+        uint64_t check = slot.check.load(memory_order_relaxed);
+
+        if ((check ^ data) == key && data != 0) {
+            entry = unpack(data);
+            return entry.bound != Bound::NONE;
+        }
+    }
+
+    return false;
+}
+
+void TranspositionTable::store(HashKey key, const TableEntry & entry) {
+    Bucket & bucket = bucketOf(key);
+    TableEntry saved = entry;
+    Slot* target = nullptr;
+
+    // the position already has a slot: a deeper bound of the current search is kept unless the new score is exact,
+    // else the slot is replaced, keeping its move if the new result has none
+    for (Slot & slot : bucket.slots) {
+        uint64_t data = slot.data.load(memory_order_relaxed);
+        if ((slot.check.load(memory_order_relaxed) ^ data) == key && data != 0) {
+            if (saved.bound != Bound::EXACT && generationOf(data) == generation && depthOf(data) > saved.depth) {
+                return;
+            }
+            if (saved.move == Move()) {
+                saved.move = unpack(data).move;
+            }
+            target = &slot;
+            break;
+        }
+    }
+
+    // else the shallowest of the depth preferred slots, the results of the previous searches counting as shallower,
+    // is replaced by a deeper result, and the last slot takes the others
+    if (!target) {
+        Slot* shallowest = &bucket.slots[0];
+        int lowest = 1 << 30;
+        for (int i = 0; i < 3; i++) {
+            uint64_t data = bucket.slots[i].data.load(memory_order_relaxed);
+            int age = (generation - generationOf(data)) & 63;
+            int value = data == 0 ? -1 : depthOf(data) - 8 * age;
+            if (value < lowest) {
+                lowest = value;
+                shallowest = &bucket.slots[i];
+            }
+        }
+
+        target = saved.depth >= lowest ? shallowest : &bucket.slots[3];
+    }
+
+    uint64_t data = pack(saved, generation);
+    target->check.store(key ^ data, memory_order_relaxed);
+    target->data.store(data, memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const {
+    int count = 0;
+    size_t sampled = mask + 1 < 250 ? mask + 1 : 250;
+    for (size_t i = 0; i < sampled; i++) {
+        for (const Slot & slot : buckets[i].slots) {
+            uint64_t data = slot.data.load(memory_order_relaxed);
+            if (data != 0 && generationOf(data) == generation) {
+                count++;
+            }
+        }
+    }
+
+    return count * 1000 / int(sampled * 4);
+}
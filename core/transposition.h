@@ -0,0 +1,115 @@
+/**
+ * @file transposition.h
+ * @brief Header file for the transposition table shared by the searches
+ */
+
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "move.h"
+#include "zobrist.h"
+
+using namespace std;
+
+/**
+ * @enum Bound
+ * @brief Kind of the score saved for a position
+*/
+enum class Bound {
+    NONE,
+    UPPER,  ///< every move failed low, the score is at most this one
+    LOWER,  ///< a move failed high, the score is at least this one
+    EXACT   ///< score of the principal variation
+};
+
+/**
+ * @struct TableEntry
+ * @brief Result of a search saved for a position
+*/
+struct TableEntry {
+    Move move;      ///< best move found, may be empty
+    int score;      ///< score for the player to move, mates counted from the position
+    int depth;      ///< depth of the search
+    Bound bound;    ///< kind of the score
+};
+
+/**
+ * @class TranspositionTable
+ * @brief Fixed size hash table of search results, read and written by several threads without lock
+ *
+ * The entries are grouped by 4 in 64 bytes buckets, one cache line. Three of them keep the deepest
+ * results of the bucket, the last one is always replaced. Each entry stores its data and the key of the
+ * position XORed with it: an entry half written by another thread doesn't match any key and is ignored.
+*/
+class TranspositionTable {
+private:
+    struct Slot {
+        atomic<uint64_t> check;  ///< key of the position XOR data
+        atomic<uint64_t> data;   ///< move, score, depth, bound and generation packed
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[4];
+    };
+
+    unique_ptr<Bucket[]> buckets;
+    size_t mask = 0;
+    uint8_t generation = 0;
+
+    /**
+     * @brief Get the bucket of a position
+     * @param key The key of the position
+     * @return The bucket where the position is saved
+    */
+    Bucket & bucketOf(HashKey key) const;
+public:
+    /**
+     * @brief Allocate an empty table
+     * @param megabytes The size of the table, rounded down to a power of two buckets
+    */
+    TranspositionTable(size_t megabytes);
+
+    /**
+     * @brief Change the size of the table, emptying it
+     * @param megabytes The size of the table, rounded down to a power of two buckets
+    */
+    void resize(size_t megabytes);
+
+    /**
+     * @brief Remove every entry
+    */
+    void clear();
+
+    /**
+     * @brief Start a new search, the entries of the previous ones are replaced first
+    */
+    void newSearch();
+
+    /**
+     * @brief Look for the saved result of a position
+     * @param key The key of the position
+     * @param entry The saved result, set if it is found
+     * @return true if the position is found, false otherwise
+    */
+    bool probe(HashKey key, TableEntry & entry) const;
+
+    /**
+     * @brief Save the result of a search of a position, unless the position has a deeper bound of the current
+     * search and the new score is not exact
+     * @param key The key of the position
+     * @param entry The result to save
+    */
+    void store(HashKey key, const TableEntry & entry);
+
+    /**
+     * @brief Estimate how full the table is, from its first buckets
+     * @return The number of entries of the current search per thousand
+    */
+    int hashfull() const;
+};
+
+#endif
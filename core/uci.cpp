@@ -0,0 +1,289 @@
+/**
+ * @file uci.cpp
+ * @brief Implementation file for the Universal Chess Interface (UCI) front-end
+ */
+
+#include "uci.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "board.h"
+#include "nnue.h"
+#include "pawns.h"
+#include "search.h"
+#include "weights.h"
+
+/**
+ * @struct UciSession
+ * @brief State of the front-end: the position given by the GUI and the search running on it
+*/
+struct UciSession {
+    ostream & output;
+    mutex outputMutex;                  ///< the worker and the reading thread both write answers
+
+    Board board;
+    shared_ptr<TranspositionTable> table;
+    vector<PawnTable> pawnTables;       ///< pawn table of each search thread, kept between the searches
+    size_t hashMegabytes;
+    int threads;
+
+    thread worker;
+    atomic<bool> stopRequest;
+    mutex stopMutex;
+    condition_variable stopCondition;   ///< wakes an infinite search that has nothing left to search
+
+    UciSession(ostream & output, size_t hashMegabytes, int threads) :
+        output(output),
+        table(make_shared<TranspositionTable>(hashMegabytes)),
+        hashMegabytes(hashMegabytes),
+        threads(threads),
+        stopRequest(false)
+    {}
+};
+
+/**
+ * @brief Write a line of answer, at once
+*/
+static void send(UciSession & session, const string & line) {
+    lock_guard<mutex> lock(session.outputMutex);
+    session.output << line << endl;
+}
+
+/**
+ * @brief Stop the running search if there is one, and wait for its best move to be sent
+*/
+static void stopSearch(UciSession & session) {
+    if (!session.worker.joinable()) {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(session.stopMutex);
+        session.stopRequest.store(true);
+    }
+    session.stopCondition.notify_all();
+    session.worker.join();
+}
+
+// ------------------------------------------------
+//                   COMMANDS
+// ------------------------------------------------
+
+/**
+ * @brief Answer "uci" with the name of the engine and its options
+*/
+static void sendIdentity(UciSession & session) {
+    send(session, "id name Echecs");
+    send(session, "id author Echecs");
+    send(session, "option name Hash type spin default " + to_string(session.hashMegabytes) + " min 1 max 65536");
+    send(session, "option name Threads type spin default " + to_string(session.threads) + " min 1 max 256");
+    send(session, "option name EvalFile type string default <empty>");
+    send(session, "option name WeightsFile type string default <empty>");
+    send(session, "uciok");
+}
+
+/**
+ * @brief Apply "setoption name <name> value <value>"
+*/
+static void setOption(UciSession & session, istringstream & stream) {
+    string token, name, value;
+    stream >> token;
+    while (stream >> token && token != "value") {
+        name += (name.empty() ? "" : " ") + token;
+    }
+    while (stream >> token) {
+        value += (value.empty() ? "" : " ") + token;
+    }
+
+    // a value that is not a number is ignored, the option keeping its value
+    int number = 0;
+    istringstream numberStream(value);
+    bool isNumber = numberStream >> number && numberStream.peek() == EOF;
+
+    if (name == "Hash" && isNumber) {
+        session.hashMegabytes = max(1, number);
+        session.table->resize(session.hashMegabytes);
+    } else if (name == "Threads" && isNumber) {
+        session.threads = max(1, number);
+    } else if (name == "EvalFile" && value != "<empty>" && !value.empty()) {
+        if (!loadNetwork(value)) {
+            send(session, "info string cannot load network " + value);
+        }
+    } else if (name == "WeightsFile" && value != "<empty>" && !value.empty()) {
+        if (!loadEvalWeights(value)) {
+            send(session, "info string cannot load weights " + value);
+        }
+        // the scores kept by the board and the pawn tables were computed with the previous weights, the GUI sends the
+        // position again before go
+        session.board.loadFen(STARTING_FEN);
+        session.pawnTables.clear();
+    }
+}
+
+/**
+ * @brief Apply "position startpos|fen <fen> [moves <move>...]", the moves being written like "e2e4" or "e7e8q"
+*/
+static void setPosition(UciSession & session, istringstream & stream) {
+    string token, fen;
+    stream >> token;
+    if (token == "startpos") {
+        fen = STARTING_FEN;
+        stream >> token;
+    } else if (token == "fen") {
+        while (stream >> token && token != "moves") {
+            fen += (fen.empty() ? "" : " ") + token;
+        }
+    } else {
+        return;
+    }
+
+    if (!session.board.loadFen(fen)) {
+        send(session, "info string invalid fen " + fen);
+        session.board.loadFen(STARTING_FEN);
+        return;
+    }
+
+    while (stream >> token) {
+        MoveList moves;
+        session.board.generateLegalMoves(moves);
+
+        bool found = false;
+        for (int i = 0; i < moves.size() && !found; i++) {
+            char text[6];
+            moves[i].write(text);
+            if (token == text) {
+                session.board.makeMove(moves[i]);
+                found = true;
+            }
+        }
+
+        if (!found) {
+            send(session, "info string illegal move " + token);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Write the "info" line of a completed iteration
+ * @param result The result of the iteration
+ * @param hashfull The filling of the transposition table, per thousand
+*/
+static string infoLine(const SearchResult & result, int hashfull) {
+    ostringstream line;
+    line << "info depth " << result.depth << " score ";
+    if (isMateScore(result.score)) {
+        int moves = (MATE_SCORE - abs(result.score) + 1) / 2;
+        line << "mate " << (result.score > 0 ? moves : -moves);
+    } else {
+        line << "cp " << result.score;
+    }
+    line << " nodes " << result.nodes << " time " << result.time;
+    line << " nps " << result.nodes * 1000 / max<int64_t>(1, result.time);
+    line << " hashfull " << hashfull << " pv";
+    for (Move move : result.pv) {
+        char text[6];
+        move.write(text);
+        line << " " << text;
+    }
+    return line.str();
+}
+
+/**
+ * @brief Start the search of "go [wtime <ms>] [btime <ms>] [winc <ms>] [binc <ms>] [movestogo <n>] [depth <n>]
+ * [nodes <n>] [movetime <ms>] [infinite]" on the worker thread, which sends the best move when it ends
+*/
+static void startSearch(UciSession & session, istringstream & stream) {
+    SearchLimits limits;
+    bool infinite = false;
+    string token;
+    while (stream >> token) {
+        if (token == "wtime") {
+            stream >> limits.clockTime[colorIndex(Color::WHITE)];
+        } else if (token == "btime") {
+            stream >> limits.clockTime[colorIndex(Color::BLACK)];
+        } else if (token == "winc") {
+            stream >> limits.increment[colorIndex(Color::WHITE)];
+        } else if (token == "binc") {
+            stream >> limits.increment[colorIndex(Color::BLACK)];
+        } else if (token == "movestogo") {
+            stream >> limits.movesToGo;
+        } else if (token == "depth") {
+            stream >> limits.maxDepth;
+        } else if (token == "nodes") {
+            stream >> limits.maxNodes;
+        } else if (token == "movetime") {
+            stream >> limits.maxTime;
+        } else if (token == "infinite") {
+            infinite = true;
+        }
+    }
+    limits.threads = session.threads;
+    limits.stopRequest = &session.stopRequest;
+    session.stopRequest.store(false);
+
+    // the worker searches its own copy, the position may be changed while it searches
+    session.worker = thread([&session, limits, infinite, board = session.board]() mutable {
+        SearchResult result = searchBestMove(board, limits, session.table.get(), &session.pawnTables, [&session](const SearchResult & iteration) {
+            send(session, infoLine(iteration, session.table->hashfull()));
+        });
+
+        // an infinite search only gives its move when asked to stop
+        if (infinite) {
+            unique_lock<mutex> lock(session.stopMutex);
+            session.stopCondition.wait(lock, [&session]() { return session.stopRequest.load(); });
+        }
+
+        char text[6] = "0000";
+        if (result.bestMove != Move()) {
+            result.bestMove.write(text);
+        }
+        send(session, string("bestmove ") + text);
+    });
+}
+
+// ------------------------------------------------
+//                  MAIN LOOP
+// ------------------------------------------------
+
+int runUci(istream & input, ostream & output, size_t hashMegabytes, int threads) {
+    UciSession session(output, hashMegabytes, threads);
+    session.board.loadFen(STARTING_FEN);
+
+    string line;
+    while (getline(input, line)) {
+        istringstream stream(line);
+        string command;
+        stream >> command;
+
+        if (command == "uci") {
+            sendIdentity(session);
+        } else if (command == "isready") {
+            send(session, "readyok");
+        } else if (command == "setoption") {
+            stopSearch(session);
+            setOption(session, stream);
+        } else if (command == "ucinewgame") {
+            stopSearch(session);
+            session.table->clear();
+            session.pawnTables.clear();
+            session.board.loadFen(STARTING_FEN);
+        } else if (command == "position") {
+            stopSearch(session);
+            setPosition(session, stream);
+        } else if (command == "go") {
+            stopSearch(session);
+            startSearch(session, stream);
+        } else if (command == "stop") {
+            stopSearch(session);
+        } else if (command == "quit") {
+            break;
+        }
+    }
+
+    stopSearch(session);
+    return EXIT_SUCCESS;
+}
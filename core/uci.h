@@ -0,0 +1,28 @@
+/**
+ * @file uci.h
+ * @brief Header file for the Universal Chess Interface (UCI) front-end, to play through chess GUIs and tournament managers
+ */
+
+#ifndef UCI_H
+#define UCI_H
+
+#include <iostream>
+
+using namespace std;
+
+/**
+ * @brief Answer the UCI commands read from a stream until "quit" or the end of the stream
+ *
+ * The supported commands are uci, isready, setoption (Hash, Threads, EvalFile, WeightsFile), ucinewgame,
+ * position (startpos or fen, then moves), go (wtime, btime, winc, binc, movestogo, depth, nodes, movetime,
+ * infinite), stop and quit. The search runs on a worker thread, so the commands are still read while it
+ * searches and stop is answered at once.
+ * @param input The stream of the commands
+ * @param output The stream of the answers
+ * @param hashMegabytes The initial size of the transposition table in megabytes
+ * @param threads The initial number of search threads
+ * @return The exit code of the program
+*/
+int runUci(istream & input, ostream & output, size_t hashMegabytes = 64, int threads = 1);
+
+#endif
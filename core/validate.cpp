@@ -0,0 +1,136 @@
+/**
+ * @file validate.cpp
+ * @brief Implementation file for the parallel validation of the move transcripts
+ */
+
+#include "validate.h"
+
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "board.h"
+#include "replay.h"
+
+/**
+ * @struct GameQueue
+ * @brief Games left to a thread, a range of indexes taken from the front by the thread and from the back by thieves
+*/
+struct GameQueue {
+    mutex lock;
+    size_t begin = 0;   ///< next game to play
+    size_t end = 0;     ///< end of the range
+};
+
+/**
+ * @brief Take the next game of a queue
+ * @param queue The queue
+ * @param game Set to the index of the game
+ * @return true if a game is taken, false if the queue is empty
+*/
+static bool popGame(GameQueue & queue, size_t & game) {
+    lock_guard<mutex> guard(queue.lock);
+    if (queue.begin == queue.end) {
+        return false;
+    }
+
+    game = queue.begin++;
+    return true;
+}
+
+/**
+ * @brief Move the back half of the queue of another thread to the empty queue of a thread
+ * @param queues The queues of all the threads
+ * @param thief The index of the thread stealing
+ * @return true if games are stolen, false if all the other queues are empty
+*/
+static bool stealGames(vector<GameQueue> & queues, size_t thief) {
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        GameQueue & victim = queues[(thief + offset) % queues.size()];
+
+        size_t begin, end;
+        {
+            lock_guard<mutex> guard(victim.lock);
+            if (victim.begin == victim.end) {
+                continue;
+            }
+
+            // the victim keeps the first half, a single game left is taken
+            end = victim.end;
+            begin = victim.begin + (victim.end - victim.begin) / 2;
+            victim.end = begin;
+        }
+
+        lock_guard<mutex> guard(queues[thief].lock);
+        queues[thief].begin = begin;
+        queues[thief].end = end;
+        return true;
+    }
+
+    return false;
+}
+
+vector<string> validateGames(const vector<string> & games, int threads) {
+    size_t count = max<size_t>(1, min<size_t>(max(1, threads), games.size()));
+    vector<string> results(games.size());
+
+    // each thread starts with a contiguous share of the games
+    vector<GameQueue> queues(count);
+    for (size_t i = 0; i < count; i++) {
+        queues[i].begin = games.size() * i / count;
+        queues[i].end = games.size() * (i + 1) / count;
+    }
+
+    auto worker = [&](size_t id) {
+        Board board;
+        size_t game;
+        while (true) {
+            // the stolen games may be stolen again before one of them is taken, the thread then steals again
+            if (!popGame(queues[id], game)) {
+                if (!stealGames(queues, id)) {
+                    return;
+                }
+                continue;
+            }
+
+            istringstream commands(games[game]);
+            results[game] = replayGame(board, commands);
+        }
+    };
+
+    vector<thread> pool;
+    for (size_t id = 1; id < count; id++) {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    for (thread & t : pool) {
+        t.join();
+    }
+
+    return results;
+}
+
+long validateTranscripts(const string & path, ostream & output, int threads) {
+    string commands;
+    if (!loadTranscripts(path, commands)) {
+        return -1;
+    }
+
+    // the games end with a "/quit" line
+    static const string quit = "/quit\n";
+    vector<string> games;
+    size_t start = 0;
+    for (size_t line = 0; line < commands.size(); line = commands.find('\n', line) + 1) {
+        if (commands.compare(line, quit.size(), quit) == 0) {
+            games.push_back(commands.substr(start, line + quit.size() - start));
+            start = line + quit.size();
+        }
+    }
+
+    for (const string & result : validateGames(games, threads)) {
+        output << result << '\n';
+    }
+
+    output.flush();
+    return games.size();
+}
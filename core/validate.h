@@ -0,0 +1,37 @@
+/**
+ * @file validate.h
+ * @brief Header file for the parallel validation of the move transcripts, replaying the games on all the cores
+ */
+
+#ifndef VALIDATE_H
+#define VALIDATE_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Replay games on several threads, each one with its own board
+ *
+ * The games are split in one queue for each thread, in the input order. A thread plays the games of its queue
+ * from the front, and once it is empty steals the back half of the queue of another thread, so that a few very
+ * long games don't leave the other threads waiting.
+ * @param games The commands of each game, ended by "/quit" (see loadTranscripts)
+ * @param threads The number of threads
+ * @return The canonical position of the end of each game with its result, in the order of the games
+*/
+vector<string> validateGames(const vector<string> & games, int threads);
+
+/**
+ * @brief Replay all the games of a file or of a directory on several threads, writing one result line for each
+ * game in the order of the transcripts, as replayTranscripts does
+ * @param path The path of the file or of the directory of the transcripts (.txt files)
+ * @param output The stream of the canonical positions of the games
+ * @param threads The number of threads
+ * @return The number of games, -1 if the path can't be read
+*/
+long validateTranscripts(const string & path, ostream & output, int threads);
+
+#endif
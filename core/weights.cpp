@@ -0,0 +1,380 @@
+/**
+ * @file weights.cpp
+ * @brief Implementation file for the weights of the evaluation
+ */
+
+#include "weights.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @struct EvalWeights
+ * @brief Weights as written in the data file, the tables seen by White from a8 to h1
+*/
+struct EvalWeights {
+    int material[2][6];         ///< value of each piece type, by stage
+    int tables[2][6][64];       ///< bonus of each piece type on each square, by stage
+    int phase[6];               ///< weight of each piece type in the game phase
+    int pawns[2][PAWN_TERMS];   ///< pawn structure terms, by stage
+    int passed[2][8];           ///< bonus of a passed pawn by its line seen by its player, by stage
+};
+
+// weights built in the program (PeSTO tables), data/weights.txt is written from them by saveEvalWeights
+static EvalWeights weights = {
+    {
+        {82, 337, 365, 477, 1025, 0},
+        {94, 281, 297, 512, 936, 0}
+    },
+    {
+        { // middlegame
+            {
+                   0,    0,    0,    0,    0,    0,    0,    0,
+                  98,  134,   61,   95,   68,  126,   34,  -11,
+                  -6,    7,   26,   31,   65,   56,   25,  -20,
+                 -14,   13,    6,   21,   23,   12,   17,  -23,
+                 -27,   -2,   -5,   12,   17,    6,   10,  -25,
+                 -26,   -4,   -4,  -10,    3,    3,   33,  -12,
+                 -35,   -1,  -20,  -23,  -15,   24,   38,  -22,
+                   0,    0,    0,    0,    0,    0,    0,    0
+            },
+            {
+                -167,  -89,  -34,  -49,   61,  -97,  -15, -107,
+                 -73,  -41,   72,   36,   23,   62,    7,  -17,
+                 -47,   60,   37,   65,   84,  129,   73,   44,
+                  -9,   17,   19,   53,   37,   69,   18,   22,
+                 -13,    4,   16,   13,   28,   19,   21,   -8,
+                 -23,   -9,   12,   10,   19,   17,   25,  -16,
+                 -29,  -53,  -12,   -3,   -1,   18,  -14,  -19,
+                -105,  -21,  -58,  -33,  -17,  -28,  -19,  -23
+            },
+            {
+                 -29,    4,  -82,  -37,  -25,  -42,    7,   -8,
+                 -26,   16,  -18,  -13,   30,   59,   18,  -47,
+                 -16,   37,   43,   40,   35,   50,   37,   -2,
+                  -4,    5,   19,   50,   37,   37,    7,   -2,
+                  -6,   13,   13,   26,   34,   12,   10,    4,
+                   0,   15,   15,   15,   14,   27,   18,   10,
+                   4,   15,   16,    0,    7,   21,   33,    1,
+                 -33,   -3,  -14,  -21,  -13,  -12,  -39,  -21
+            },
+            {
+                  32,   42,   32,   51,   63,    9,   31,   43,
+                  27,   32,   58,   62,   80,   67,   26,   44,
+                  -5,   19,   26,   36,   17,   45,   61,   16,
+                 -24,  -11,    7,   26,   24,   35,   -8,  -20,
+                 -36,  -26,  -12,   -1,    9,   -7,    6,  -23,
+                 -45,  -25,  -16,  -17,    3,    0,   -5,  -33,
+                 -44,  -16,  -20,   -9,   -1,   11,   -6,  -71,
+                 -19,  -13,    1,   17,   16,    7,  -37,  -26
+            },
+            {
+                 -28,    0,   29,   12,   59,   44,   43,   45,
+                 -24,  -39,   -5,    1,  -16,   57,   28,   54,
+                 -13,  -17,    7,    8,   29,   56,   47,   57,
+                 -27,  -27,  -16,  -16,   -1,   17,   -2,    1,
+                  -9,  -26,   -9,  -10,   -2,   -4,    3,   -3,
+                 -14,    2,  -11,   -2,   -5,    2,   14,    5,
+                 -35,   -8,   11,    2,    8,   15,   -3,    1,
+                  -1,  -18,   -9,   10,  -15,  -25,  -31,  -50
+            },
+            {
+                 -65,   23,   16,  -15,  -56,  -34,    2,   13,
+                  29,   -1,  -20,   -7,   -8,   -4,  -38,  -29,
+                  -9,   24,    2,  -16,  -20,    6,   22,  -22,
+                 -17,  -20,  -12,  -27,  -30,  -25,  -14,  -36,
+                 -49,   -1,  -27,  -39,  -46,  -44,  -33,  -51,
+                 -14,  -14,  -22,  -46,  -44,  -30,  -15,  -27,
+                   1,    7,   -8,  -64,  -43,  -16,    9,    8,
+                 -15,   36,   12,  -54,    8,  -28,   24,   14
+            }
+        },
+        { // endgame
+            {
+                   0,    0,    0,    0,    0,    0,    0,    0,
+                 178,  173,  158,  134,  147,  132,  165,  187,
+                  94,  100,   85,   67,   56,   53,   82,   84,
+                  32,   24,   13,    5,   -2,    4,   17,   17,
+                  13,    9,   -3,   -7,   -7,   -8,    3,   -1,
+                   4,    7,   -6,    1,    0,   -5,   -1,   -8,
+                  13,    8,    8,   10,   13,    0,    2,   -7,
+                   0,    0,    0,    0,    0,    0,    0,    0
+            },
+            {
+                 -58,  -38,  -13,  -28,  -31,  -27,  -63,  -99,
+                 -25,   -8,  -25,   -2,   -9,  -25,  -24,  -52,
+                 -24,  -20,   10,    9,   -1,   -9,  -19,  -41,
+                 -17,    3,   22,   22,   22,   11,    8,  -18,
+                 -18,   -6,   16,   25,   16,   17,    4,  -18,
+                 -23,   -3,   -1,   15,   10,   -3,  -20,  -22,
+                 -42,  -20,  -10,   -5,   -2,  -20,  -23,  -44,
+                 -29,  -51,  -23,  -15,  -22,  -18,  -50,  -64
+            },
+            {
+                 -14,  -21,  -11,   -8,   -7,   -9,  -17,  -24,
+                  -8,   -4,    7,  -12,   -3,  -13,   -4,  -14,
+                   2,   -8,    0,   -1,   -2,    6,    0,    4,
+                  -3,    9,   12,    9,   14,   10,    3,    2,
+                  -6,    3,   13,   19,    7,   10,   -3,   -9,
+                 -12,   -3,    8,   10,   13,    3,   -7,  -15,
+                 -14,  -18,   -7,   -1,    4,   -9,  -15,  -27,
+                 -23,   -9,  -23,   -5,   -9,  -16,   -5,  -17
+            },
+            {
+                  13,   10,   18,   15,   12,   12,    8,    5,
+                  11,   13,   13,   11,   -3,    3,    8,    3,
+                   7,    7,    7,    5,    4,   -3,   -5,   -3,
+                   4,    3,   13,    1,    2,    1,   -1,    2,
+                   3,    5,    8,    4,   -5,   -6,   -8,  -11,
+                  -4,    0,   -5,   -1,   -7,  -12,   -8,  -16,
+                  -6,   -6,    0,    2,   -9,   -9,  -11,   -3,
+                  -9,    2,    3,   -1,   -5,  -13,    4,  -20
+            },
+            {
+                  -9,   22,   22,   27,   27,   19,   10,   20,
+                 -17,   20,   32,   41,   58,   25,   30,    0,
+                 -20,    6,    9,   49,   47,   35,   19,    9,
+                   3,   22,   24,   45,   57,   40,   57,   36,
+                 -18,   28,   19,   47,   31,   34,   39,   23,
+                 -16,  -27,   15,    6,    9,   17,   10,    5,
+                 -22,  -23,  -30,  -16,  -16,  -23,  -36,  -32,
+                 -33,  -28,  -22,  -43,   -5,  -32,  -20,  -41
+            },
+            {
+                 -74,  -35,  -18,  -18,  -11,   15,    4,  -17,
+                 -12,   17,   14,   17,   17,   38,   23,   11,
+                  10,   17,   23,   15,   20,   45,   44,   13,
+                  -8,   22,   24,   27,   26,   33,   26,    3,
+                 -18,   -4,   21,   24,   27,   23,    9,  -11,
+                 -19,   -3,   11,   21,   23,   16,    7,   -9,
+                 -27,  -11,    4,   13,   14,    4,   -5,  -17,
+                 -53,  -34,  -21,  -11,  -28,  -14,  -24,  -43
+            }
+        }
+    },
+    {0, 1, 1, 2, 4, 0},
+    {
+        {-10, -12, -8, 12, 6},
+        {-25, -15, -10, 0, 0}
+    },
+    {
+        {0, 5, 10, 15, 30, 50, 80, 0},
+        {0, 10, 20, 35, 60, 100, 150, 0}
+    }
+};
+
+int pieceSquareScores[2][2][6][64];
+int phaseWeights[6];
+int pawnTermScores[2][PAWN_TERMS];
+int passedPawnScores[2][8];
+
+static const char* stageNames[2] = {"middlegame", "endgame"};
+static const char* typeNames[6] = {"pawn", "knight", "bishop", "rook", "queen", "king"};
+
+/**
+ * @brief Fill the tables of the evaluation from the weights
+*/
+static void buildTables(const EvalWeights & source) {
+    for (int stage = 0; stage < 2; stage++) {
+        for (int type = 0; type < 6; type++) {
+            for (int index = 0; index < 64; index++) {
+                // the tables are read from the 8th line, Black seeing them mirrored
+                int line = 7 - index / 8;
+                int column = index % 8;
+                int score = source.material[stage][type] + source.tables[stage][type][index];
+                pieceSquareScores[stage][colorIndex(Color::WHITE)][type][line * 8 + column] = score;
+                pieceSquareScores[stage][colorIndex(Color::BLACK)][type][(7 - line) * 8 + column] = -score;
+            }
+        }
+    }
+
+    for (int type = 0; type < 6; type++) {
+        phaseWeights[type] = source.phase[type];
+    }
+
+    for (int stage = 0; stage < 2; stage++) {
+        for (int term = 0; term < PAWN_TERMS; term++) {
+            pawnTermScores[stage][term] = source.pawns[stage][term];
+        }
+        for (int line = 0; line < 8; line++) {
+            passedPawnScores[stage][line] = source.passed[stage][line];
+        }
+    }
+}
+
+/**
+ * @brief Fill the tables of the evaluation from the weights built in the program
+ * @return true once the tables are filled
+*/
+static bool buildDefaultTables() {
+    buildTables(weights);
+    return true;
+}
+
+void initEvalWeights() {
+    // built once, even if several threads ask for it at the same time
+    static bool built = buildDefaultTables();
+    (void) built;
+}
+
+// ------------------------------------------------
+//                  DATA FILE
+// ------------------------------------------------
+
+/**
+ * @brief Find a name in a table of names
+ * @param names The table of names
+ * @param count The number of names
+ * @param name The name to find
+ * @return The index of the name, -1 if it is not found
+*/
+static int findName(const char* const* names, int count, const string & name) {
+    for (int i = 0; i < count; i++) {
+        if (name == names[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Read a list of numbers
+ * @param stream The stream to read
+ * @param values The numbers to fill
+ * @param count The number of numbers
+ * @return true if every number is read, false otherwise
+*/
+static bool readValues(istream & stream, int* values, int count) {
+    for (int i = 0; i < count; i++) {
+        if (!(stream >> values[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool loadEvalWeights(const string & path) {
+    ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    // the comments are dropped, the entries may then span several lines
+    stringstream content;
+    string line;
+    while (getline(file, line)) {
+        content << line.substr(0, line.find('#')) << '\n';
+    }
+
+    EvalWeights loaded = weights;
+    string keyword;
+    while (content >> keyword) {
+        string stageName, typeName;
+        int stage, type;
+
+        if (keyword == "phase") {
+            if (!readValues(content, loaded.phase, 6)) {
+                return false;
+            }
+        } else if (keyword == "material") {
+            content >> stageName;
+            stage = findName(stageNames, 2, stageName);
+            if (stage == -1 || !readValues(content, loaded.material[stage], 6)) {
+                return false;
+            }
+        } else if (keyword == "pawns" || keyword == "passed") {
+            content >> stageName;
+            stage = findName(stageNames, 2, stageName);
+            if (stage == -1) {
+                return false;
+            }
+
+            bool read = keyword == "pawns" ?
+                readValues(content, loaded.pawns[stage], PAWN_TERMS) :
+                readValues(content, loaded.passed[stage], 8);
+            if (!read) {
+                return false;
+            }
+        } else if (keyword == "table") {
+            content >> stageName >> typeName;
+            stage = findName(stageNames, 2, stageName);
+            type = findName(typeNames, 6, typeName);
+            if (stage == -1 || type == -1 || !readValues(content, loaded.tables[stage][type], 64)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    weights = loaded;
+    buildTables(weights);
+    return true;
+}
+
+/**
+ * @brief Write a list of numbers on a line
+ * @param file The stream to write
+ * @param values The numbers
+ * @param count The number of numbers
+*/
+static void writeValues(ostream & file, const int* values, int count) {
+    for (int i = 0; i < count; i++) {
+        file << ' ' << values[i];
+    }
+    file << '\n';
+}
+
+bool saveEvalWeights(const string & path) {
+    ofstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    file <<
+        "# Evaluation weights of the computer player, in centipawns\n"
+        "#\n"
+        "# phase <pawn> <knight> <bishop> <rook> <queen> <king>\n"
+        "#     weight of each piece in the game phase, the middlegame scores count fully when the weights add up to 24\n"
+        "# material <middlegame|endgame> <pawn> <knight> <bishop> <rook> <queen> <king>\n"
+        "#     value of each piece\n"
+        "# pawns <middlegame|endgame> <doubled> <isolated> <backward> <shield near> <shield far>\n"
+        "#     pawn structure terms, for each pawn, and pawn shield of the king, for each pawn one or two lines in front of it\n"
+        "# passed <middlegame|endgame> <line 1> ... <line 8>\n"
+        "#     bonus of a passed pawn by its line, seen by its player\n"
+        "# table <middlegame|endgame> <pawn|knight|bishop|rook|queen|king>\n"
+        "#     bonus of the piece on each square seen by White, from a8 to h8 down to a1 to h1, mirrored for Black\n"
+        "#\n"
+        "# Every entry is optional, the missing ones keep the values built in the program.\n"
+        "\n";
+
+    file << "phase";
+    writeValues(file, weights.phase, 6);
+    for (int stage = 0; stage < 2; stage++) {
+        file << "material " << stageNames[stage];
+        writeValues(file, weights.material[stage], 6);
+    }
+    for (int stage = 0; stage < 2; stage++) {
+        file << "pawns " << stageNames[stage];
+        writeValues(file, weights.pawns[stage], PAWN_TERMS);
+    }
+    for (int stage = 0; stage < 2; stage++) {
+        file << "passed " << stageNames[stage];
+        writeValues(file, weights.passed[stage], 8);
+    }
+
+    for (int type = 0; type < 6; type++) {
+        for (int stage = 0; stage < 2; stage++) {
+            file << "\ntable " << stageNames[stage] << ' ' << typeNames[type] << '\n';
+            for (int line = 0; line < 8; line++) {
+                for (int column = 0; column < 8; column++) {
+                    file << (column ? " " : "") << setw(4) << weights.tables[stage][type][line * 8 + column];
+                }
+                file << '\n';
+            }
+        }
+    }
+
+    return bool(file);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file weights.h
+ * @brief Header file for the weights of the evaluation: piece values, piece-square tables and game phase
+ */
+
+#ifndef WEIGHTS_H
+#define WEIGHTS_H
+
+#include <string>
+
+#include "pieces.h"
+
+using namespace std;
+
+/**
+ * @enum Stage
+ * @brief Stage of the game a score is tuned for, the evaluation blending both with the game phase
+*/
+enum Stage {
+    MIDDLEGAME = 0,
+    ENDGAME = 1
+};
+
+/**
+ * @enum PawnTerm
+ * @brief Terms of the pawn structure and of the pawn shield of the king
+*/
+enum PawnTerm {
+    DOUBLED_PAWN = 0,   ///< penalty of a pawn with another pawn of its color in front of it
+    ISOLATED_PAWN,      ///< penalty of a pawn without pawn of its color on the columns beside it
+    BACKWARD_PAWN,      ///< penalty of a pawn left behind the pawns beside it, with its next square attacked by an opponent pawn
+    SHIELD_NEAR,        ///< bonus of a pawn just in front of its king, or beside this square
+    SHIELD_FAR,         ///< bonus of a pawn two lines in front of its king, or beside this square
+    PAWN_TERMS
+};
+
+/**
+ * @brief Game phase of the starting position, the middlegame scores count fully at this phase or above
+*/
+const int MAX_PHASE = 24;
+
+extern int pieceSquareScores[2][2][6][64];
+extern int phaseWeights[6];
+extern int pawnTermScores[2][PAWN_TERMS];
+extern int passedPawnScores[2][8];
+
+/**
+ * @brief Build the tables from the weights built in the program, safe to call several times
+*/
+void initEvalWeights();
+
+/**
+ * @brief Load the weights from a data file and rebuild the tables, the entries missing from the file keeping their value
+ * @param path The path of the file
+ * @return true if the file is read, false if it can't be opened or is invalid (the tables are then left unchanged)
+*/
+bool loadEvalWeights(const string & path);
+
+/**
+ * @brief Write the weights in use to a data file, in the format read by loadEvalWeights
+ *
+ * data/weights.txt is written this way from the weights built in the program ("make weights"), so that both stay the same.
+ * @param path The path of the file
+ * @return true if the file is written, false otherwise
+*/
+bool saveEvalWeights(const string & path);
+
+/**
+ * @brief Get the score of a piece standing on a square, its value included
+ * @param stage The stage of the game
+ * @param color The color of the piece
+ * @param type The type of the piece
+ * @param square The index of the square
+ * @return The score in centipawns, positive for White and negative for Black
+*/
+inline int pieceSquareScore(Stage stage, Color color, PieceType type, int square) {
+    return pieceSquareScores[stage][colorIndex(color)][typeIndex(type)][square];
+}
+
+/**
+ * @brief Get the weight of a piece in the game phase
+ * @param type The type of the piece
+ * @return The weight of the piece
+*/
+inline int phaseWeight(PieceType type) {
+    return phaseWeights[typeIndex(type)];
+}
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ * @file zobrist.cpp
+ * @brief Implementation file for the Zobrist keys used to hash the positions
+ */
+
+#include "zobrist.h"
+
+HashKey zobristPieces[2][6][64];
+HashKey zobristCastling[16];
+HashKey zobristEnPassant[8];
+HashKey zobristBlackToMove;
+
+/**
+ * @brief Get the next number of a splitmix64 sequence, so the keys are the same on every run
+ * @param state The state of the generator
+ * @return The next pseudo random number
+*/
+static HashKey nextRandom(HashKey & state) {
+    HashKey z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Fill the key tables
+ * @return true once the tables are filled
+*/
+static bool buildKeys() {
+    HashKey state = 0x2545F4914F6CDD1DULL;
+
+    for (int color = 0; color < 2; color++) {
+        for (int type = 0; type < 6; type++) {
+            for (int square = 0; square < 64; square++) {
+                zobristPieces[color][type][square] = nextRandom(state);
+            }
+        }
+    }
+
+    // losing every castling right adds nothing to the key
+    zobristCastling[0] = 0;
+    for (int rights = 1; rights < 16; rights++) {
+        zobristCastling[rights] = nextRandom(state);
+    }
+
+    for (int column = 0; column < 8; column++) {
+        zobristEnPassant[column] = nextRandom(state);
+    }
+
+    zobristBlackToMove = nextRandom(state);
+    return true;
+}
+
+void initZobrist() {
+    // built once, even if several threads ask for it at the same time
+    static bool built = buildKeys();
+    (void) built;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file zobrist.h
+ * @brief Header file for the Zobrist keys used to hash the positions
+ */
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+
+#include "pieces.h"
+
+using namespace std;
+
+/**
+ * @brief A 64-bit hash of a position, the XOR of the keys of its features
+*/
+typedef uint64_t HashKey;
+
+extern HashKey zobristPieces[2][6][64];
+extern HashKey zobristCastling[16];
+extern HashKey zobristEnPassant[8];
+extern HashKey zobristBlackToMove;
+
+/**
+ * @brief Fill the key tables with fixed pseudo random numbers, safe to call several times
+*/
+void initZobrist();
+
+/**
+ * @brief Get the key of a piece standing on a square
+ * @param color The color of the piece
+ * @param type The type of the piece
+ * @param square The index of the square
+ * @return The key of the piece on the square
+*/
+inline HashKey pieceKey(Color color, PieceType type, int square) {
+    return zobristPieces[colorIndex(color)][typeIndex(type)][square];
+}
+
+/**
+ * @brief Get the key of a combination of castling rights
+ * @param castlingRights The castling rights (combination of CastlingRight flags)
+ * @return The key of the castling rights
+*/
+inline HashKey castlingKey(int castlingRights) {
+    return zobristCastling[castlingRights];
+}
+
+/**
+ * @brief Get the key of the column of an en passant square
+ * @param column The column of the en passant square
+ * @return The key of the column
+*/
+inline HashKey enPassantKey(int column) {
+    return zobristEnPassant[column];
+}
+
+#endif
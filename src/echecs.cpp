@@ -1,21 +1,194 @@
 /**
  * @file echecs.cpp
  * @brief Main file for the chess game redirecting to the core
+ *
+ * Usage: echecs [--white=human|engine] [--black=human|engine] [--depth=<n>] [--nodes=<n>] [--movetime=<ms>] [--hash=<MB>]
+ *               [--wtime=<ms>] [--btime=<ms>] [--winc=<ms>] [--binc=<ms>]
+ *               [--threads=<n>] [--weights=<file>] [--nnue=<file>] [--uci] [--replay=<file|directory>]
+ *               [--validate=<file|directory>] [--pgn=<file>] [--save-weights=<file>]
+ * Both players are humans by default, the limits apply together to each move of the computer (one second if none
+ * is given) and the transposition table of the computer takes 64 MB by default. With a clock, the computer shares
+ * the time left on it between its moves, the increment being added after each of them. The evaluation weights built in
+ * the program may be replaced by the ones of a data file (see data/weights.txt), or by a neural
+ * network (see core/nnue.h for the format of its file). With --uci, the board is not displayed and
+ * the program answers the commands of a chess GUI on the standard input instead (see core/uci.h). With
+ * --replay, the move transcripts of a file or of a directory are played without display, and the canonical
+ * position of the end of each game is written on its own line (see core/replay.h). --validate does the
+ * same on all the cores, or on the number of threads given with --threads (see core/validate.h). --pgn
+ * does it for the games of a PGN file, written in Standard Algebraic Notation (see core/pgn.h). --save-weights
+ * writes the evaluation weights in use to a data file, data/weights.txt being written this way.
  */
 #include <string>
 #include <vector>
+#include <charconv>
 #include <iostream>
+#include <thread>
 #include "../core/board.h"
+#include "../core/pgn.h"
+#include "../core/replay.h"
+#include "../core/uci.h"
+#include "../core/validate.h"
 
 using namespace std;
 
-int main() {
+/**
+ * @brief Read the kind of player given by an option
+ * @param value The value of the option ("human" or "engine")
+ * @param isEngine Set to true for the computer, false for a human
+ * @return true if the value is valid, false otherwise
+*/
+bool parsePlayer(const string & value, bool & isEngine) {
+    if (value != "human" && value != "engine") {
+        return false;
+    }
+
+    isEngine = value == "engine";
+    return true;
+}
+
+/**
+ * @brief Read the whole number given by an option
+ * @param value The value of the option
+ * @param number Set to the number if the value is valid
+ * @param minimum The smallest valid number
+ * @return true if the value is a number of the type, not below the minimum, false otherwise
+*/
+template <typename Number>
+bool parseNumber(const string & value, Number & number, Number minimum) {
+    Number parsed;
+    const char* end = value.data() + value.size();
+    auto [last, error] = from_chars(value.data(), end, parsed);
+    if (error != errc() || last != end || parsed < minimum) {
+        return false;
+    }
+
+    number = parsed;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool whiteEngine = false;
+    bool blackEngine = false;
+    SearchLimits limits;
+    size_t hashMegabytes = 64;
+    bool uci = false;
+    string replayPath;
+    string validatePath;
+    string pgnPath;
+    string weightsPath;
+    bool threadsGiven = false;
+
+    for (int i = 1; i < argc; i++) {
+        string argument = argv[i];
+        size_t equal = argument.find('=');
+        string name = argument.substr(0, equal);
+        string value = equal == string::npos ? "" : argument.substr(equal + 1);
+
+        bool valid = !value.empty();
+        if (argument == "--uci") {
+            uci = valid = true;
+        } else if (valid && name == "--replay") {
+            replayPath = value;
+        } else if (valid && name == "--validate") {
+            validatePath = value;
+        } else if (valid && name == "--pgn") {
+            pgnPath = value;
+        } else if (valid && name == "--save-weights") {
+            weightsPath = value;
+        } else if (valid && name == "--white") {
+            valid = parsePlayer(value, whiteEngine);
+        } else if (valid && name == "--black") {
+            valid = parsePlayer(value, blackEngine);
+        } else if (valid && name == "--depth") {
+            valid = parseNumber(value, limits.maxDepth, 1);
+        } else if (valid && name == "--nodes") {
+            valid = parseNumber<uint64_t>(value, limits.maxNodes, 1);
+        } else if (valid && name == "--movetime") {
+            valid = parseNumber<int64_t>(value, limits.maxTime, 1);
+        } else if (valid && (name == "--wtime" || name == "--btime")) {
+            valid = parseNumber<int64_t>(value, limits.clockTime[name == "--wtime" ? 0 : 1], 0);
+        } else if (valid && (name == "--winc" || name == "--binc")) {
+            valid = parseNumber<int64_t>(value, limits.increment[name == "--winc" ? 0 : 1], 0);
+        } else if (valid && name == "--hash") {
+            valid = parseNumber<size_t>(value, hashMegabytes, 1);
+        } else if (valid && name == "--threads") {
+            valid = threadsGiven = parseNumber(value, limits.threads, 1);
+        } else if (valid && name == "--weights") {
+            if (!loadEvalWeights(value)) {
+                cerr << "Fichier de poids invalide: " << value << endl;
+                return EXIT_FAILURE;
+            }
+        } else if (valid && name == "--nnue") {
+            if (!loadNetwork(value)) {
+                cerr << "Fichier de réseau invalide: " << value << endl;
+                return EXIT_FAILURE;
+            }
+            cerr << "Réseau chargé: " << value << " (" << networkInstructions() << ")" << endl;
+        } else {
+            valid = false;
+        }
+
+        if (!valid) {
+            cerr << "Option invalide: " << argument << endl;
+            cerr << "Usage: " << argv[0] << " [--white=human|engine] [--black=human|engine]";
+            cerr << " [--depth=<n>] [--nodes=<n>] [--movetime=<ms>] [--hash=<MB>] [--threads=<n>] [--weights=<file>]";
+            cerr << " [--nnue=<file>] [--wtime=<ms>] [--btime=<ms>] [--winc=<ms>] [--binc=<ms>] [--uci]";
+            cerr << " [--replay=<file|directory>] [--validate=<file|directory>]";
+            cerr << " [--pgn=<file>] [--save-weights=<file>]" << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // without any other limit, the computer thinks one second per move
+    if (!limits.maxDepth && !limits.maxNodes && !limits.maxTime && !limits.clockTime[0] && !limits.clockTime[1]) {
+        limits.maxTime = 1000;
+    }
+
+    // the weights are written once all the options are read, with the ones of --weights if it is given
+    if (!weightsPath.empty()) {
+        if (!saveEvalWeights(weightsPath)) {
+            cerr << "Impossible d'écrire les poids: " << weightsPath << endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if (uci) {
+        return runUci(cin, cout, hashMegabytes, limits.threads);
+    }
+
+    if (!replayPath.empty()) {
+        if (replayTranscripts(replayPath, cout) < 0) {
+            cerr << "Transcriptions illisibles: " << replayPath << endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if (!validatePath.empty()) {
+        int threads = threadsGiven ? limits.threads : max(1, int(thread::hardware_concurrency()));
+        if (validateTranscripts(validatePath, cout, threads) < 0) {
+            cerr << "Transcriptions illisibles: " << validatePath << endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if (!pgnPath.empty()) {
+        if (replayPgn(pgnPath, cout) < 0) {
+            cerr << "Fichier PGN illisible: " << pgnPath << endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
     printBegin();
     
     Board chessBoard;
+    chessBoard.setEnginePlayers(whiteEngine, blackEngine, limits, hashMegabytes);
     chessBoard.initGame();
 
     printQuit();
     cout << chessBoard.canonical_position() << endl;
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
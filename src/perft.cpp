@@ -0,0 +1,216 @@
+/**
+ * @file perft.cpp
+ * @brief Perft tool counting the nodes of the move tree of known positions, to check and time the move generation
+ *
+ * Usage:
+ *   perft [options] [file.epd] [max depth]     check every position of the file up to the max depth
+ *   perft [options] --divide <depth> <fen>     print the node count under each move of a position
+ *
+ * Options:
+ *   --threads <n>      count with n threads (1 by default)
+ *   --hash <MB>        reuse the counts of the subtrees already seen with a table of this size (none by default)
+ *
+ * Each line of the EPD file is a FEN record followed by the expected counts: "<fen> ;D1 20 ;D2 400".
+ */
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include "../core/perft.h"
+
+using namespace std;
+
+/**
+ * @struct PerftOptions
+ * @brief Settings of the counts given on the command line
+*/
+struct PerftOptions {
+    int threads = 1;
+    PerftTable* table = nullptr;
+};
+
+/**
+ * @brief Time a perft run and print its node count, duration and speed
+ * @param board The board to count from
+ * @param depth The depth of the tree
+ * @param expected The expected number of nodes
+ * @param options The number of threads and the table
+ * @param nodes Set to the number of nodes counted
+ * @return true if the count is the expected one, false otherwise
+*/
+bool runPerft(const Board & board, int depth, uint64_t expected, const PerftOptions & options, uint64_t & nodes) {
+    auto start = chrono::steady_clock::now();
+    nodes = perftParallel(board, depth, options.threads, options.table);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "  D" << depth;
+    cout << setw(14) << nodes << " noeuds";
+    cout << fixed << setprecision(3) << setw(10) << seconds << " s";
+    cout << setprecision(1) << setw(10) << (seconds > 0 ? nodes / seconds / 1e6 : 0) << " Mnps";
+
+    if (nodes != expected) {
+        cout << "  ERREUR (attendu " << expected << ")" << endl;
+        return false;
+    }
+
+    cout << "  OK" << endl;
+    return true;
+}
+
+/**
+ * @brief Check every position of an EPD file up to a depth
+ * @param path The path of the EPD file
+ * @param maxDepth The deepest count to check
+ * @param options The number of threads and the table
+ * @return true if every count is the expected one, false otherwise
+*/
+bool runSuite(const string & path, int maxDepth, const PerftOptions & options) {
+    ifstream file(path);
+    if (!file) {
+        cerr << "Impossible d'ouvrir " << path << endl;
+        return false;
+    }
+
+    Board board;
+    bool success = true;
+    uint64_t totalNodes = 0;
+    auto start = chrono::steady_clock::now();
+
+    string line;
+    while (getline(file, line)) {
+        size_t separator = line.find(';');
+        if (line.empty() || line[0] == '#' || separator == string::npos) {
+            continue;
+        }
+
+        string fen = line.substr(0, line.find_last_not_of(' ', separator - 1) + 1);
+        if (!board.loadFen(fen)) {
+            cerr << "FEN invalide: " << fen << endl;
+            success = false;
+            continue;
+        }
+        cout << fen << endl;
+
+        // the expected counts follow, as ";D<depth> <nodes>"
+        istringstream counts(line.substr(separator));
+        string field;
+        while (getline(counts, field, ';')) {
+            int depth = 0;
+            unsigned long long expected = 0;
+            if (sscanf(field.c_str(), " D%d %llu", &depth, &expected) != 2 || depth > maxDepth) {
+                continue;
+            }
+
+            uint64_t nodes = 0;
+            success = runPerft(board, depth, expected, options, nodes) && success;
+            totalNodes += nodes;
+        }
+    }
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << endl << "Total: " << totalNodes << " noeuds en " << fixed << setprecision(3) << seconds << " s";
+    cout << " (" << setprecision(1) << (seconds > 0 ? totalNodes / seconds / 1e6 : 0) << " Mnps)" << endl;
+    cout << (success ? "Tous les comptes sont corrects." : "Des comptes sont incorrects.") << endl;
+
+    return success;
+}
+
+/**
+ * @brief Read a number given on the command line (depth, number of threads, size of the table)
+ * @param value The argument
+ * @param number Set to the number if the argument is valid
+ * @param minimum The smallest valid number
+ * @return true if the argument is a whole number not below the minimum, false otherwise
+*/
+bool parseNumber(const string & value, int & number, int minimum) {
+    istringstream stream(value);
+    int parsed = 0;
+    if (!(stream >> parsed) || stream.peek() != EOF || parsed < minimum) {
+        return false;
+    }
+
+    number = parsed;
+    return true;
+}
+
+/**
+ * @brief Print the command line of the tool
+ * @param program The name of the program
+*/
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [--threads <n>] [--hash <MB>] [file.epd] [max depth]" << endl;
+    cerr << "       " << program << " [--threads <n>] [--hash <MB>] --divide <depth> <fen>" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    PerftOptions options;
+    unique_ptr<PerftTable> table;
+    vector<string> arguments;
+
+    for (int i = 1; i < argc; i++) {
+        string argument = argv[i];
+        if (argument == "--threads" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], options.threads, 1)) {
+                cerr << "Nombre de threads invalide: " << argv[i] << endl;
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (argument == "--hash" && i + 1 < argc) {
+            // 0 counts without table
+            int megabytes = 0;
+            if (!parseNumber(argv[++i], megabytes, 0)) {
+                cerr << "Taille de table invalide: " << argv[i] << endl;
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            if (megabytes > 0) {
+                table = make_unique<PerftTable>(megabytes);
+                options.table = table.get();
+            }
+        } else {
+            arguments.push_back(argument);
+        }
+    }
+
+    if (arguments.size() >= 3 && arguments[0] == "--divide") {
+        // the FEN record may be given in one or several arguments
+        string fen = arguments[2];
+        for (size_t i = 3; i < arguments.size(); i++) {
+            fen += " " + arguments[i];
+        }
+
+        Board board;
+        if (!board.loadFen(fen)) {
+            cerr << "FEN invalide: " << fen << endl;
+            return EXIT_FAILURE;
+        }
+
+        int depth = 0;
+        if (!parseNumber(arguments[1], depth, 1)) {
+            cerr << "Profondeur invalide: " << arguments[1] << endl;
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        uint64_t nodes = perftDivide(board, depth, cout, options.threads, options.table);
+        cout << endl << "Total: " << nodes << endl;
+        return EXIT_SUCCESS;
+    }
+
+    string path = arguments.size() >= 1 ? arguments[0] : "tests/perft/perft.epd";
+    int maxDepth = 5;
+    if (arguments.size() >= 2 && !parseNumber(arguments[1], maxDepth, 1)) {
+        cerr << "Profondeur invalide: " << arguments[1] << endl;
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    cout << options.threads << " thread(s), ";
+    cout << (options.table ? "table de hachage" : "sans table de hachage") << endl << endl;
+
+    return runSuite(path, maxDepth, options) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,80 @@
+#!/bin/bash
+
+# the directory where the games transcripts are
+DATA=data
+
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+NC='\033[0m' # No Color
+
+# same checks as test-level.sh, but all the games of all the levels are played by a single
+# process with --replay, which writes the final 'position<space>res' of each game on its own
+# line, in the order of the names of the transcripts
+
+if [ $# -ge 1 ]; then
+	CHESS_PROG="$1"
+	printf "* Setting ${BLUE}${CHESS_PROG}${NC} passed as a parameter.\n"
+else  # No chess executable passed as parameter
+	CHESS_PROG="../src/echecs"
+	echo "* Using executable ${CHESS_PROG} defined in script."
+fi
+
+# test chess binary exists and executable
+if ! [ -x "$CHESS_PROG" ]; then
+	echo "* Error: $CHESS_PROG is not executable."
+	exit 1
+fi
+
+games=$(LC_ALL=C ls -1 ${DATA}/*.txt 2>/dev/null)
+if [ -z "$games" ]; then
+	echo "* Error : no test games found in directory: $(pwd)/${DATA}"
+	exit 1
+fi
+
+outputs=$("${CHESS_PROG}" --replay=${DATA})
+retcode=$?
+if [ $retcode -ne 0 ]; then
+	printf " -> ${RED}[test error] (exit code=$retcode) ${NC} $CHESS_PROG --replay=${DATA} ended in error\n"
+	exit 1
+fi
+
+expected=$(echo "$games" | wc -l)
+played=$(echo "$outputs" | wc -l)
+if [ "$expected" -ne "$played" ]; then
+	printf " -> ${RED}[test error]${NC} $played results for $expected games\n"
+	exit 1
+fi
+
+failed_tests=""
+i=0
+for g in $games
+do
+	i=$((i + 1))
+	ref_ll=$(tail -1 $g)
+	out_ll=$(echo "$outputs" | sed -n "${i}p")
+
+	for field in 1 2; do
+		ref=$(echo $ref_ll | cut -f$field -d' ')
+		out=$(echo $out_ll | cut -f$field -d' ')
+		if [ "$ref" != "$out" ]; then
+			[ $field -eq 1 ] && what=position || what=result
+			echo "  -> $g: final $what differs from reference:"
+			printf "   ref:[${GREEN}$ref${NC}]\n"
+			printf "   you:[${RED}$out${NC}]\n"
+			failed_tests="${failed_tests} ${g}_(${what})"
+		fi
+	done
+done
+
+if [ -n "${failed_tests}" ]; then
+	echo ".----------------------------"
+	echo "| failed tests:              "
+	for t in ${failed_tests}; do
+		echo "| $t "
+	done
+	echo '`----------------------------'
+	exit 1
+fi
+
+printf "${GREEN}* $expected games replayed: OK${NC}\n"